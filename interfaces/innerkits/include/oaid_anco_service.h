@@ -45,6 +45,24 @@ struct AncoAccessRecordInfo {
     int32_t count;
 };
 
+/**
+ * Upper bound of the rows of one SetAncoSwitchStatusBatch call.
+ */
+constexpr size_t ANCO_SWITCH_STATUS_BATCH_MAX_SIZE = 1000;
+
+/**
+ * Upper bound of the page size, larger requests are clamped to it.
+ */
+constexpr int32_t ANCO_ACCESS_RECORD_PAGE_MAX_SIZE = 500;
+
+/**
+ * One page of anco access records, newest first.
+ */
+struct AncoAccessRecordPage {
+    std::vector<AncoAccessRecordInfo> records;
+    std::string nextCursor;  // Opaque, pass it back to read the next page. Empty on the last page.
+};
+
 /**
  * AncoService class for internal API.
  * Provides static methods for anco switch status and access records.
@@ -63,6 +81,14 @@ public:
     static bool SetAncoSwitchStatus(int32_t userId, const std::string& bundleName,
         const std::string& uid, int32_t status);
 
+    /**
+     * Set the anco switch status of several lake apps in one call, all rows are applied or none.
+     *
+     * @param infos Rows to set, at most ANCO_SWITCH_STATUS_BATCH_MAX_SIZE.
+     * @return bool, true for success, false for failure.
+     */
+    static bool SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos);
+
     /**
      * Get anco switch status for lake app.
      *
@@ -84,6 +110,20 @@ public:
      */
     static std::vector<AncoAccessRecordInfo> GetAncoAccessRecords(int32_t userId,
         const std::string& bundleName = "", const std::string& uid = "");
+
+    /**
+     * Get one page of anco access records, newest first.
+     *
+     * @param userId User space ID.
+     * @param cursor Empty for the first page, otherwise the nextCursor of the previous page.
+     * @param pageSize Records per page, at most ANCO_ACCESS_RECORD_PAGE_MAX_SIZE.
+     * @param page Records of the page and the cursor of the next one.
+     * @param bundleName App bundle name (optional, must be paired with uid).
+     * @param uid App uid (optional, must be paired with bundleName).
+     * @return int32_t, ERR_OK for success.
+     */
+    static int32_t GetAncoAccessRecordsPage(int32_t userId, const std::string& cursor, int32_t pageSize,
+        AncoAccessRecordPage& page, const std::string& bundleName = "", const std::string& uid = "");
 };
 
 } // namespace Cloud
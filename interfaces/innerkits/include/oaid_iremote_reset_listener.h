@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_IREMOTE_RESET_LISTENER_H
+#define OHOS_CLOUD_OAID_IREMOTE_RESET_LISTENER_H
+
+#include <cstdint>
+
+#include "iremote_broker.h"
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * Pushed by the OAID service whenever the OAID seen by apps changes, so client side caches can be dropped.
+ */
+class IOaidResetListener : public IRemoteBroker {
+public:
+    DECLARE_INTERFACE_DESCRIPTOR(u"ohos.cloud.oaid.IOaidResetListener");
+    enum class ResetListenerCode {
+        ON_OAID_RESET = 0,
+    };
+
+    /**
+     * Called after the OAID changed.
+     *
+     * @param generation OAID generation after the change.
+     */
+    virtual void OnOaidReset(uint64_t generation) = 0;
+};
+} // namespace Cloud
+} // namespace OHOS
+#endif // OHOS_CLOUD_OAID_IREMOTE_RESET_LISTENER_H
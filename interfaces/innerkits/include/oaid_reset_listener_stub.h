@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_RESET_LISTENER_STUB_H
+#define OHOS_CLOUD_OAID_RESET_LISTENER_STUB_H
+
+#include "iremote_stub.h"
+#include "oaid_iremote_reset_listener.h"
+
+namespace OHOS {
+namespace Cloud {
+class OaidResetListenerStub : public IRemoteStub<IOaidResetListener> {
+public:
+    OaidResetListenerStub() = default;
+    virtual ~OaidResetListenerStub() override = default;
+
+    int32_t OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply, MessageOption& option) override;
+
+private:
+    int32_t HandleOaidReset(MessageParcel& data, MessageParcel& reply);
+};
+} // namespace Cloud
+} // namespace OHOS
+#endif // OHOS_CLOUD_OAID_RESET_LISTENER_STUB_H
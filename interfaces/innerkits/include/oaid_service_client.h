@@ -16,6 +16,7 @@
 #ifndef OHOS_CLOUD_OAID_SERVICE_CLIENT_H
 #define OHOS_CLOUD_OAID_SERVICE_CLIENT_H
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -29,6 +30,7 @@
 #include "config_policy_utils.h"
 #include "tokenid_kit.h"
 #include "oaid_anco_service.h"
+#include "oaid_reset_listener_stub.h"
 
 /**
  * load time out: 10s
@@ -59,6 +61,26 @@ public:
      */
     std::string GetOAID();
 
+    /**
+     * Get open advertising id without formatting it.
+     *
+     * @return OaidValue, OAID, all zero on failure.
+     */
+    OaidValue GetOAIDValue();
+
+    /**
+     * Enable or disable the process local OAID cache, disabled by default. While enabled, repeated reads are
+     * served from memory until the service pushes an OAID change or dies.
+     */
+    void SetOAIDCacheEnabled(bool enabled);
+
+    /**
+     * Called when the service pushes an OAID change.
+     *
+     * @param generation OAID generation after the change.
+     */
+    void OnOaidReset(uint64_t generation);
+
     /**
      * Reset open advertising id.
      */
@@ -81,6 +103,14 @@ public:
     bool SetAncoSwitchStatus(int32_t userId, const std::string& bundleName,
         const std::string& uid, int32_t status);
 
+    /**
+     * Set anco switch status of several apps in one transaction.
+     *
+     * @param infos Rows to set.
+     * @return bool, true for success, false for failure.
+     */
+    bool SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos);
+
     /**
      * Get anco switch status.
      *
@@ -103,6 +133,20 @@ public:
     std::vector<AncoAccessRecordInfo> GetAncoAccessRecords(int32_t userId,
         const std::string& bundleName, const std::string& uid);
 
+    /**
+     * Get one page of anco access records, newest first.
+     *
+     * @param userId User space ID.
+     * @param bundleName App bundle name (optional).
+     * @param uid App uid (optional).
+     * @param cursor Empty for the first page, otherwise the nextCursor of the previous page.
+     * @param pageSize Records per page.
+     * @param page Records of the page and the cursor of the next one.
+     * @return int32_t, ERR_OK for success.
+     */
+    int32_t GetAncoAccessRecordsPage(int32_t userId, const std::string& bundleName, const std::string& uid,
+        const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page);
+
     void OnRemoteSaDied(const wptr<IRemoteObject>& object);
 
     void LoadServerFail();
@@ -128,6 +172,18 @@ private:
     sptr<IOAIDService> oaidServiceProxy_;
     sptr<OAIDSaDeathRecipient> deathRecipient_;
     bool CheckPermission(const std::string &permissionName);
+    bool RegisterResetListenerLocked();
+    void InvalidateOAIDCache(uint64_t resetGeneration);
+
+    std::atomic<bool> oaidCacheEnabled_ {false};
+    std::mutex oaidCacheMutex_;
+    bool oaidCacheValid_ = false;
+    OaidValue cachedOaid_;
+    uint64_t lastResetGeneration_ = 0;
+    uint64_t oaidCacheEpoch_ = 0;
+    // Guarded by getOaidProxyMutex_, the listener has to be registered again on every service instance.
+    sptr<OaidResetListenerStub> resetListener_;
+    bool resetListenerRegistered_ = false;
 };
 } // namespace Cloud
 } // namespace OHOS
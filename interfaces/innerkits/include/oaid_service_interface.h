@@ -21,7 +21,9 @@
 
 #include "iremote_broker.h"
 #include "oaid_iremote_config_observer.h"
+#include "oaid_iremote_reset_listener.h"
 #include "oaid_anco_service.h"
+#include "oaid_value.h"
 
 namespace OHOS {
 namespace Cloud {
@@ -30,9 +32,10 @@ public:
     /**
      * Get open advertising id.
      *
-     * @return std::string, OAID.
+     * @param generation OAID generation the returned value belongs to.
+     * @return OaidValue, OAID, all zero on failure.
      */
-    virtual std::string GetOAID() = 0;
+    virtual OaidValue GetOAID(uint64_t &generation) = 0;
 
     /**
      * Reset open advertising id.
@@ -44,6 +47,11 @@ public:
      */
     virtual int32_t RegisterObserver(const sptr<IRemoteConfigObserver>& observer) = 0;
 
+    /**
+     * Register a listener notified whenever the OAID generation changes.
+     */
+    virtual int32_t RegisterResetListener(const sptr<IOaidResetListener>& listener) = 0;
+
     /**
      * Set anco switch status.
      *
@@ -56,6 +64,14 @@ public:
     virtual bool SetAncoSwitchStatus(int32_t userId, const std::string& bundleName,
         const std::string& uid, int32_t status) = 0;
 
+    /**
+     * Set anco switch status of several apps in one transaction.
+     *
+     * @param infos Rows to set.
+     * @return bool, true for success, false for failure.
+     */
+    virtual bool SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos) = 0;
+
     /**
      * Get anco switch status.
      *
@@ -78,6 +94,20 @@ public:
     virtual std::vector<AncoAccessRecordInfo> GetAncoAccessRecords(int32_t userId,
         const std::string& bundleName, const std::string& uid) = 0;
 
+    /**
+     * Get one page of anco access records, newest first.
+     *
+     * @param userId User space ID.
+     * @param bundleName App bundle name (optional).
+     * @param uid App uid (optional).
+     * @param cursor Empty for the first page, otherwise the nextCursor of the previous page.
+     * @param pageSize Records per page.
+     * @param page Records of the page and the cursor of the next one.
+     * @return int32_t, ERR_OK for success.
+     */
+    virtual int32_t GetAncoAccessRecordsPage(int32_t userId, const std::string& bundleName,
+        const std::string& uid, const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page) = 0;
+
     virtual std::string GetAncoOAID() = 0;
 
     virtual int32_t InsertAccessRecord(const int32_t userId, const std::string bundleName, const std::string uid) = 0;
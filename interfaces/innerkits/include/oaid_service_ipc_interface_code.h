@@ -28,6 +28,9 @@ namespace Cloud {
     GET_ANCO_ACCESS_RECORDS = 5,
     GET_ANCO_OAID = 6,
     SET_ANCO_ACCESS_RECORDS = 7,
+    REGISTER_RESET_LISTENER = 8,
+    GET_ANCO_ACCESS_RECORDS_PAGE = 9,
+    SET_ANCO_SWITCH_STATUS_BATCH = 10,
 };
 } // namespace Cloud
 } // namespace OHOS
@@ -33,9 +33,10 @@ public:
     /**
      * Get open advertising id.
      *
-     * @return std::string, OAID.
+     * @param generation OAID generation the returned value belongs to.
+     * @return OaidValue, OAID, all zero on failure.
      */
-    std::string GetOAID() override;
+    OaidValue GetOAID(uint64_t &generation) override;
 
     /**
      * Reset open advertising id.
@@ -47,6 +48,8 @@ public:
      */
     int32_t RegisterObserver(const sptr<IRemoteConfigObserver>& observer) override;
 
+    int32_t RegisterResetListener(const sptr<IOaidResetListener>& listener) override;
+
     /**
      * Set anco switch status.
      *
@@ -59,6 +62,8 @@ public:
     bool SetAncoSwitchStatus(int32_t userId, const std::string& bundleName,
         const std::string& uid, int32_t status) override;
 
+    bool SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos) override;
+
     /**
      * Get anco switch status.
      *
@@ -81,6 +86,9 @@ public:
     std::vector<AncoAccessRecordInfo> GetAncoAccessRecords(int32_t userId,
         const std::string& bundleName, const std::string& uid) override;
 
+    int32_t GetAncoAccessRecordsPage(int32_t userId, const std::string& bundleName, const std::string& uid,
+        const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page) override;
+
     std::string GetAncoOAID() override;
 
     int32_t InsertAccessRecord(const int32_t userId, const std::string bundleName, const std::string uid) override;
@@ -38,6 +38,29 @@ bool AncoService::SetAncoSwitchStatus(int32_t userId, const std::string& bundleN
     return Cloud::OAIDServiceClient::GetInstance()->SetAncoSwitchStatus(userId, bundleName, uid, status);
 }
 
+bool AncoService::SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos)
+{
+    if (infos.empty() || infos.size() > ANCO_SWITCH_STATUS_BATCH_MAX_SIZE) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid parameter: batch size %{public}zu out of range", infos.size());
+        return false;
+    }
+
+    for (const auto& info : infos) {
+        if (info.userId < 0 || info.bundleName.empty() || info.uid.empty()) {
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid parameter: userId/bundleName/uid invalid");
+            return false;
+        }
+        if (info.status != SWITCH_ON && info.status != SWITCH_OFF) {
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid parameter: status must be 0 or 1");
+            return false;
+        }
+    }
+
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Client SetAncoSwitchStatusBatch called");
+
+    return Cloud::OAIDServiceClient::GetInstance()->SetAncoSwitchStatusBatch(infos);
+}
+
 std::vector<AncoSwitchStatusInfo> AncoService::GetAncoSwitchStatus(int32_t userId,
     const std::string& bundleName, const std::string& uid)
 {
@@ -78,5 +101,34 @@ std::vector<AncoAccessRecordInfo> AncoService::GetAncoAccessRecords(int32_t user
     return Cloud::OAIDServiceClient::GetInstance()->GetAncoAccessRecords(userId, bundleName, uid);
 }
 
+int32_t AncoService::GetAncoAccessRecordsPage(int32_t userId, const std::string& cursor, int32_t pageSize,
+    AncoAccessRecordPage& page, const std::string& bundleName, const std::string& uid)
+{
+    page.records.clear();
+    page.nextCursor.clear();
+    if (userId < 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid parameter: userId cannot be negative");
+        return ERR_INVALID_PARAM;
+    }
+
+    if (pageSize <= 0 || pageSize > ANCO_ACCESS_RECORD_PAGE_MAX_SIZE) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid parameter: pageSize must be in [1, %{public}d]",
+            ANCO_ACCESS_RECORD_PAGE_MAX_SIZE);
+        return ERR_INVALID_PARAM;
+    }
+
+    bool hasBundleName = !bundleName.empty();
+    bool hasUid = !uid.empty();
+    if (hasBundleName != hasUid) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid parameter: bundleName and uid must be both present or both absent");
+        return ERR_INVALID_PARAM;
+    }
+
+    OAID_HILOGI(OAID_MODULE_SERVICE, "GetAncoAccessRecordsPage called");
+
+    return Cloud::OAIDServiceClient::GetInstance()->GetAncoAccessRecordsPage(userId, bundleName, uid, cursor,
+        pageSize, page);
+}
+
 } // namespace Cloud
 } // namespace OHOS
\ No newline at end of file
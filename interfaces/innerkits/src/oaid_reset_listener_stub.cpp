@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_reset_listener_stub.h"
+#include "oaid_common.h"
+
+namespace OHOS {
+namespace Cloud {
+int32_t OaidResetListenerStub::OnRemoteRequest(
+    uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
+{
+    if (data.ReadInterfaceToken() != OaidResetListenerStub::GetDescriptor()) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "read descriptor failed.");
+        return ERR_INVALID_PARAM;
+    }
+    switch (code) {
+        case static_cast<uint32_t>(ResetListenerCode::ON_OAID_RESET):
+            return HandleOaidReset(data, reply);
+        default:
+            return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
+    }
+}
+
+int32_t OaidResetListenerStub::HandleOaidReset(MessageParcel &data, MessageParcel &reply)
+{
+    uint64_t generation = 0;
+    if (!data.ReadUint64(generation)) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "parcel read generation failed.");
+        return ERR_INVALID_PARAM;
+    }
+    OnOaidReset(generation);
+    return ERR_OK;
+}
+}  // namespace Cloud
+}  // namespace OHOS
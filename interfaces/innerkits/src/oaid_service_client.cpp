@@ -42,6 +42,14 @@ static const int8_t RESET_OAID_DEFAULT_CODE = 0;
 std::mutex OAIDServiceClient::instanceLock_;
 sptr<OAIDServiceClient> OAIDServiceClient::instance_;
 
+class OAIDClientResetListener : public OaidResetListenerStub {
+public:
+    void OnOaidReset(uint64_t generation) override
+    {
+        OAIDServiceClient::GetInstance()->OnOaidReset(generation);
+    }
+};
+
 class OAIDServiceLoadCallback : public SystemAbilityLoadCallbackStub {
 public:
     void OnLoadSystemAbilitySuccess(int32_t systemAbilityId, const sptr<IRemoteObject>& remoteObject) override
@@ -135,11 +143,26 @@ bool OAIDServiceClient::LoadService(int8_t waitTime)
 }
 
 std::string OAIDServiceClient::GetOAID()
+{
+    return GetOAIDValue().ToString();
+}
+
+OaidValue OAIDServiceClient::GetOAIDValue()
 {
     if (!CheckPermission(OAID_TRACKING_CONSENT_PERMISSION)) {
         OAID_HILOGW(
             OAID_MODULE_SERVICE, "get oaid not granted the app tracking permission");
-        return OAID_ALLZERO_STR;
+        return OaidValue();
+    }
+
+    bool cacheEnabled = oaidCacheEnabled_.load(std::memory_order_acquire);
+    uint64_t cacheEpoch = 0;
+    if (cacheEnabled) {
+        std::lock_guard<std::mutex> cacheLock(oaidCacheMutex_);
+        if (oaidCacheValid_) {
+            return cachedOaid_;
+        }
+        cacheEpoch = oaidCacheEpoch_;
     }
 
     if (!LoadService()) {
@@ -150,17 +173,72 @@ std::string OAIDServiceClient::GetOAID()
     std::lock_guard<std::mutex> lock(getOaidProxyMutex_);
     if (oaidServiceProxy_ == nullptr) {
         OAID_HILOGE(OAID_MODULE_CLIENT, "Quit because redoing load oaid service failed.");
-        return OAID_ALLZERO_STR;
+        return OaidValue();
     }
 
-    auto oaid = oaidServiceProxy_->GetOAID();
-    if (oaid == "") {
+    // Without a registered listener a reset could not be seen, so nothing is cached then.
+    bool canCache = cacheEnabled && RegisterResetListenerLocked();
+    uint64_t generation = 0;
+    OaidValue oaid = oaidServiceProxy_->GetOAID(generation);
+    if (oaid.IsZero()) {
         OAID_HILOGE(OAID_MODULE_CLIENT, "Get OAID failed.");
-        return OAID_ALLZERO_STR;
+        return oaid;
+    }
+    if (canCache) {
+        std::lock_guard<std::mutex> cacheLock(oaidCacheMutex_);
+        // Drop the reply if a reset was pushed or the service died while it was in flight.
+        if (cacheEpoch == oaidCacheEpoch_ && generation >= lastResetGeneration_) {
+            cachedOaid_ = oaid;
+            oaidCacheValid_ = true;
+        }
     }
     return oaid;
 }
 
+void OAIDServiceClient::SetOAIDCacheEnabled(bool enabled)
+{
+    oaidCacheEnabled_.store(enabled, std::memory_order_release);
+    if (!enabled) {
+        InvalidateOAIDCache(0);
+    }
+}
+
+void OAIDServiceClient::OnOaidReset(uint64_t generation)
+{
+    OAID_HILOGI(OAID_MODULE_CLIENT, "OAID changed, generation=%{public}" PRIu64, generation);
+    InvalidateOAIDCache(generation);
+}
+
+void OAIDServiceClient::InvalidateOAIDCache(uint64_t resetGeneration)
+{
+    std::lock_guard<std::mutex> cacheLock(oaidCacheMutex_);
+    oaidCacheValid_ = false;
+    oaidCacheEpoch_++;
+    if (resetGeneration > lastResetGeneration_) {
+        lastResetGeneration_ = resetGeneration;
+    }
+}
+
+bool OAIDServiceClient::RegisterResetListenerLocked()
+{
+    if (resetListenerRegistered_) {
+        return true;
+    }
+    if (resetListener_ == nullptr) {
+        resetListener_ = new (std::nothrow) OAIDClientResetListener();
+        if (resetListener_ == nullptr) {
+            return false;
+        }
+    }
+    int32_t ret = oaidServiceProxy_->RegisterResetListener(resetListener_);
+    if (ret != ERR_OK) {
+        OAID_HILOGW(OAID_MODULE_CLIENT, "RegisterResetListener failed, ret=%{public}d", ret);
+        return false;
+    }
+    resetListenerRegistered_ = true;
+    return true;
+}
+
 int32_t OAIDServiceClient::ResetOAID()
 {
     if (!LoadService()) {
@@ -175,6 +253,8 @@ int32_t OAIDServiceClient::ResetOAID()
 
     int32_t resetResult = oaidServiceProxy_->ResetOAID();
     OAID_HILOGI(OAID_MODULE_SERVICE, "End.resetResult = %{public}d", resetResult);
+    // The pushed notification is one-way, do not serve the old OAID to this process in the meantime.
+    InvalidateOAIDCache(0);
 
     return resetResult;
 }
@@ -237,6 +317,24 @@ bool OAIDServiceClient::SetAncoSwitchStatus(int32_t userId, const std::string& b
     return result;
 }
 
+bool OAIDServiceClient::SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos)
+{
+    if (!LoadService(BROKER_LOAD_TIME_OUT)) {
+        OAID_HILOGW(OAID_MODULE_CLIENT, "Redo load oaid service.");
+    }
+
+    std::lock_guard<std::mutex> lock(getOaidProxyMutex_);
+    if (oaidServiceProxy_ == nullptr) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Quit because redoing load oaid service failed.");
+        return false;
+    }
+
+    bool result = oaidServiceProxy_->SetAncoSwitchStatusBatch(infos);
+    OAID_HILOGI(OAID_MODULE_CLIENT, "SetAncoSwitchStatusBatch End, result = %{public}d", result);
+
+    return result;
+}
+
 std::vector<AncoSwitchStatusInfo> OAIDServiceClient::GetAncoSwitchStatus(int32_t userId,
     const std::string& bundleName, const std::string& uid)
 {
@@ -278,6 +376,23 @@ std::vector<AncoAccessRecordInfo> OAIDServiceClient::GetAncoAccessRecords(int32_
     return result;
 }
 
+int32_t OAIDServiceClient::GetAncoAccessRecordsPage(int32_t userId, const std::string& bundleName,
+    const std::string& uid, const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page)
+{
+    if (!LoadService()) {
+        OAID_HILOGW(OAID_MODULE_CLIENT, "Redo load oaid service.");
+        LoadService();
+    }
+
+    std::lock_guard<std::mutex> lock(getOaidProxyMutex_);
+    if (oaidServiceProxy_ == nullptr) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Quit because redoing load oaid service failed.");
+        return ERR_SYSYTEM_ERROR;
+    }
+
+    return oaidServiceProxy_->GetAncoAccessRecordsPage(userId, bundleName, uid, cursor, pageSize, page);
+}
+
 void OAIDServiceClient::OnRemoteSaDied(const wptr<IRemoteObject>& remote)
 {
     OAID_HILOGE(OAID_MODULE_CLIENT, "OnRemoteSaDied");
@@ -292,6 +407,8 @@ void OAIDServiceClient::OnRemoteSaDied(const wptr<IRemoteObject>& remote)
         oaidServiceProxy_ = nullptr;
         OAID_HILOGI(OAID_MODULE_CLIENT, "OnRemoteSaDied END");
     }
+    resetListenerRegistered_ = false;
+    InvalidateOAIDCache(0);
 }
 
 void OAIDServiceClient::LoadServerSuccess(const sptr<IRemoteObject>& remoteObject)
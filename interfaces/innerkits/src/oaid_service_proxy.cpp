@@ -29,7 +29,7 @@ using namespace OHOS::HiviewDFX;
 OAIDServiceProxy::OAIDServiceProxy(const sptr<IRemoteObject> &object) : IRemoteProxy<IOAIDService>(object)
 {}
 
-std::string OAIDServiceProxy::GetOAID()
+OaidValue OAIDServiceProxy::GetOAID(uint64_t &generation)
 {
     OAID_HILOGI(OAID_MODULE_CLIENT, "GetOAID Begin.");
     MessageParcel data;
@@ -38,13 +38,13 @@ std::string OAIDServiceProxy::GetOAID()
     const int32_t NOPERMISSION = 305;
     if (!data.WriteInterfaceToken(GetDescriptor())) {
         OAID_HILOGE(OAID_MODULE_CLIENT, "Failed to write parcelable");
-        return "";
+        return OaidValue();
     }
 
     sptr<IRemoteObject> remote = Remote();
     if (remote == nullptr) {
         OAID_HILOGE(OAID_MODULE_CLIENT, "getoaid get remote failed");
-        return "";
+        return OaidValue();
     }
     int32_t result = remote->SendRequest(static_cast<uint32_t>(OAIDInterfaceCode::GET_OAID), data, reply, option);
     if (result != ERR_NONE) {
@@ -57,10 +57,13 @@ std::string OAIDServiceProxy::GetOAID()
             result = curError;
             OAID_HILOGE(OAID_MODULE_CLIENT, "Get OAID failed of System error, error code is: %{public}d", result);
         }
-        return "";
+        return OaidValue();
+    }
+    OaidValue oaid;
+    if (!OaidValue::ReadFromParcel(reply, oaid) || !reply.ReadUint64(generation)) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Failed to read oaid from reply");
+        return OaidValue();
     }
-    auto oaid = reply.ReadString();
-
     return oaid;
 }
 
@@ -120,6 +123,35 @@ int32_t OAIDServiceProxy::RegisterObserver(const sptr<IRemoteConfigObserver> &ob
         static_cast<uint32_t>(OAIDInterfaceCode::REGISTER_CONTROL_CONFIG_OBSERVER), data, reply, option);
 }
 
+int32_t OAIDServiceProxy::RegisterResetListener(const sptr<IOaidResetListener> &listener)
+{
+    if (!listener) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Listener is null, error code is: %{public}d", ERR_NULL_POINTER);
+        return ERR_NULL_POINTER;
+    }
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        OAID_HILOGE(OAID_MODULE_CLIENT,
+            "Failed to write RegisterResetListener InterfaceToken, error code is: %{public}d",
+            ERR_WRITE_PARCEL_FAILED);
+        return ERR_WRITE_PARCEL_FAILED;
+    }
+    if (!data.WriteRemoteObject(listener->AsObject())) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Listener write failed, error code is: %{public}d", ERR_WRITE_PARCEL_FAILED);
+        return ERR_WRITE_PARCEL_FAILED;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        OAID_HILOGI(OAID_MODULE_CLIENT, "remote is null");
+        return ERR_NULL_POINTER;
+    }
+    return remote->SendRequest(
+        static_cast<uint32_t>(OAIDInterfaceCode::REGISTER_RESET_LISTENER), data, reply, option);
+}
+
 bool OAIDServiceProxy::SetAncoSwitchStatus(int32_t userId, const std::string& bundleName,
     const std::string& uid, int32_t status)
 {
@@ -168,6 +200,47 @@ bool OAIDServiceProxy::SetAncoSwitchStatus(int32_t userId, const std::string& bu
     return ret;
 }
 
+bool OAIDServiceProxy::SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos)
+{
+    OAID_HILOGI(OAID_MODULE_CLIENT, "SetAncoSwitchStatusBatch Begin, count = %{public}zu.", infos.size());
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Failed to write parcelable");
+        return false;
+    }
+    if (!data.WriteUint32(static_cast<uint32_t>(infos.size()))) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Failed to write count");
+        return false;
+    }
+    for (const auto& info : infos) {
+        if (!data.WriteInt32(info.userId) || !data.WriteString(info.bundleName) || !data.WriteString(info.uid) ||
+            !data.WriteInt32(info.status)) {
+            OAID_HILOGE(OAID_MODULE_CLIENT, "Failed to write switch status row");
+            return false;
+        }
+    }
+
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "get remote failed");
+        return false;
+    }
+
+    int32_t result = remote->SendRequest(
+        static_cast<uint32_t>(OAIDInterfaceCode::SET_ANCO_SWITCH_STATUS_BATCH), data, reply, option);
+    if (result != ERR_NONE) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "SetAncoSwitchStatusBatch failed, error code is: %{public}d", result);
+        return false;
+    }
+
+    bool ret = reply.ReadBool();
+    OAID_HILOGI(OAID_MODULE_CLIENT, "SetAncoSwitchStatusBatch End, ret = %{public}d", ret);
+    return ret;
+}
+
 template <>
 std::optional<AncoSwitchStatusInfo> IpcSerializationTransporter::Reader::Read()
 {
@@ -355,6 +428,57 @@ std::vector<AncoAccessRecordInfo> OAIDServiceProxy::GetAncoAccessRecords(int32_t
     OAID_HILOGI(OAID_MODULE_CLIENT, "GetAncoAccessRecords End, size = %{public}zu", resultVec.size());
     return resultVec;
 }
+int32_t OAIDServiceProxy::GetAncoAccessRecordsPage(int32_t userId, const std::string& bundleName,
+    const std::string& uid, const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page)
+{
+    OAID_HILOGI(OAID_MODULE_CLIENT, "GetAncoAccessRecordsPage Begin.");
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option;
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Failed to write parcelable");
+        return ERR_WRITE_PARCEL_FAILED;
+    }
+    // Unlike WriteQueryParams, empty bundleName and uid are written too, the cursor and page size follow them.
+    if (!data.WriteInt32(userId) || !data.WriteString(bundleName) || !data.WriteString(uid) ||
+        !data.WriteString(cursor) || !data.WriteInt32(pageSize)) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "Failed to write page request");
+        return ERR_WRITE_PARCEL_FAILED;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "get remote failed");
+        return ERR_SYSYTEM_ERROR;
+    }
+    int32_t result = remote->SendRequest(
+        static_cast<uint32_t>(OAIDInterfaceCode::GET_ANCO_ACCESS_RECORDS_PAGE), data, reply, option);
+    if (result != ERR_NONE) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "GetAncoAccessRecordsPage failed, error code is: %{public}d", result);
+        return result;
+    }
+    size_t rawDataSize = reply.ReadUint64();
+    const void* rawData = reply.ReadRawData(rawDataSize);
+    if (!rawData) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "rawData is nullptr");
+        return ERR_SYSYTEM_ERROR;
+    }
+    auto readerUp = IpcSerializationTransporter::Reader::Build(static_cast<const uint8_t*>(rawData),
+        static_cast<uint32_t>(rawDataSize));
+    if (!readerUp) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "readerOpt is nullptr");
+        return ERR_SYSYTEM_ERROR;
+    }
+    auto infosOpt = readerUp->Read<std::vector<AncoAccessRecordInfo>>();
+    if (!infosOpt.has_value()) {
+        OAID_HILOGE(OAID_MODULE_CLIENT, "read ancoAccessRecordInfo failed");
+        return ERR_SYSYTEM_ERROR;
+    }
+    page.records = std::move(infosOpt.value());
+    page.nextCursor = reply.ReadString();
+    OAID_HILOGI(OAID_MODULE_CLIENT, "GetAncoAccessRecordsPage End, size = %{public}zu", page.records.size());
+    return ERR_OK;
+}
+
 std::string OAIDServiceProxy::GetAncoOAID()
 {
     OAID_HILOGI(OAID_MODULE_CLIENT, "GetAncoOAID Begin.");
@@ -41,13 +41,22 @@ napi_value OAIDInit(napi_env env, napi_value exports);
 napi_value GetOAID(napi_env env, napi_callback_info info);
 
 /**
- * Reset open advertising id.
+ * Reset open advertising id, synchronously, throwing on failure.
  *
  * @param env napi environment variable.
  * @param exports napi export variable.
  * @return napi_value, result.
  */
 napi_value ResetOAID(napi_env env, napi_callback_info info);
+
+/**
+ * Reset open advertising id on an async work item, without blocking the JS thread.
+ *
+ * @param env napi environment variable.
+ * @param exports napi export variable.
+ * @return napi_value, promise, or null when a callback is passed.
+ */
+napi_value ResetOAIDAsync(napi_env env, napi_callback_info info);
 } // namespace OAIDNapi
 } // namespace CloudNapi
 } // namespace OHOS
@@ -15,11 +15,15 @@
 
 #include "oaid.h"
 
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include <uv.h>
 #include "hilog/log.h"
 #include "oaid_common.h"
 #include "oaid_service_client.h"
+#include "oaid_value.h"
 #include "securec.h"
 
 namespace OHOS {
@@ -38,18 +42,45 @@ static const int32_t OAID_ERROR_CODE_NOT_SYSTEM_APP = 202;
 static const int32_t OAID_ERROR_NOT_IN_TRUST_LIST = 17300002;
 }  // namespace
 
-std::mutex oaidLock_;
+struct OAIDWaiter {
+    napi_ref callback = nullptr;
+    napi_deferred deferred = nullptr;
+    bool isCallback = false;
+};
 
+/**
+ * One in-flight getOAID fetch per napi_env. Calls made while it is pending attach as waiters and are all
+ * resolved from its single result, unless a reset was issued on the env since the fetch started: then they
+ * start a new fetch, so no caller gets an OAID read before its own reset. Waiters are only touched on the JS
+ * thread of their env.
+ */
 struct AsyncCallbackInfoOAID {
     napi_env env = nullptr;
     napi_async_work asyncWork = nullptr;
-    napi_ref callback = nullptr;
-    napi_deferred deferred = nullptr;
-    std::string oaid;
-    bool isCallback = false;
+    std::vector<OAIDWaiter> waiters;
+    Cloud::OaidValue oaid;
     int32_t errorCode = NO_ERROR;
+    uint64_t resetEpoch = 0;
 };
 
+// Both maps are guarded by g_inflightOAIDMutex.
+std::mutex g_inflightOAIDMutex;
+std::unordered_map<napi_env, AsyncCallbackInfoOAID *> g_inflightOAID;
+std::unordered_map<napi_env, uint64_t> g_resetEpoch;
+
+uint64_t GetResetEpochLocked(napi_env env)
+{
+    auto iter = g_resetEpoch.find(env);
+    return (iter == g_resetEpoch.end()) ? 0 : iter->second;
+}
+
+// Called by resetOAID and resetOAIDAsync, fetches started before are no longer joined by later getOAID calls.
+void BumpResetEpoch(napi_env env)
+{
+    std::lock_guard<std::mutex> lock(g_inflightOAIDMutex);
+    g_resetEpoch[env]++;
+}
+
 napi_value NapiGetNull(napi_env env)
 {
     napi_value result = nullptr;
@@ -105,12 +136,13 @@ napi_value ParaError(const napi_env &env, const napi_ref &callback)
     return promise;
 }
 
-void ReturnCallbackPromise(const napi_env &env, AsyncCallbackInfoOAID *&info, const napi_value &result)
+void ReturnCallbackPromise(const napi_env &env, const OAIDWaiter &waiter, int32_t errorCode, const napi_value &result)
 {
-    if (info->isCallback) {
-        SetCallback(env, info->callback, info->errorCode, result);
+    if (waiter.isCallback) {
+        SetCallback(env, waiter.callback, errorCode, result);
+        napi_delete_reference(env, waiter.callback);
     } else {
-        SetPromise(env, info->deferred, info->errorCode, result);
+        SetPromise(env, waiter.deferred, errorCode, result);
     }
 }
 
@@ -129,94 +161,172 @@ napi_value ParseParameters(
     return NapiGetNull(env);
 }
 
-void PaddingCallbackInfo(
-    const napi_env &env, AsyncCallbackInfoOAID *&asynccallbackinfo, const napi_ref &callback, napi_value &promise)
+void SetPromiseOrCallbackError(const napi_env &env, const OAIDWaiter &waiter)
+{
+    ReturnCallbackPromise(env, waiter, ERROR, NapiGetNull(env));
+}
+
+bool PaddingWaiter(const napi_env &env, OAIDWaiter &waiter, const napi_ref &callback, napi_value &promise)
 {
     if (callback != nullptr) {
-        asynccallbackinfo->isCallback = true;
-        asynccallbackinfo->callback = callback;
-    } else {
-        asynccallbackinfo->isCallback = false;
-        napi_deferred deferred = nullptr;
-        NAPI_CALL_RETURN_VOID(env, napi_create_promise(env, &deferred, &promise));
-        asynccallbackinfo->deferred = deferred;
+        waiter.isCallback = true;
+        waiter.callback = callback;
+        return true;
     }
+    waiter.isCallback = false;
+    napi_deferred deferred = nullptr;
+    if (napi_create_promise(env, &deferred, &promise) != napi_ok) {
+        return false;
+    }
+    waiter.deferred = deferred;
+    return true;
 }
 
 void GetOAIDExecuteCallBack(napi_env env, void *data)
 {
-    std::lock_guard<std::mutex> autoLock(oaidLock_);
     AsyncCallbackInfoOAID *asynccallbackinfo = reinterpret_cast<AsyncCallbackInfoOAID *>(data);
-
-    asynccallbackinfo->oaid = Cloud::OAIDServiceClient::GetInstance()->GetOAID();
-    if (asynccallbackinfo->oaid.empty()) {
-        asynccallbackinfo->errorCode = ERROR;
-        return;
-    }
+    asynccallbackinfo->oaid = Cloud::OAIDServiceClient::GetInstance()->GetOAIDValue();
 }
 
 void GetOAIDCompleteCallBack(napi_env env, napi_status status, void *data)
 {
     AsyncCallbackInfoOAID *asynccallbackinfo = reinterpret_cast<AsyncCallbackInfoOAID *>(data);
+    {
+        // Detach first, so a getOAID issued from a resolved callback starts a new fetch. A fetch of a newer
+        // epoch may have replaced this one already, it stays attached.
+        std::lock_guard<std::mutex> lock(g_inflightOAIDMutex);
+        auto iter = g_inflightOAID.find(env);
+        if (iter != g_inflightOAID.end() && iter->second == asynccallbackinfo) {
+            g_inflightOAID.erase(iter);
+        }
+    }
+    OAID_HILOGI(OHOS::Cloud::OAID_MODULE_JS_NAPI, "getOAID resolves %{public}zu waiters",
+        asynccallbackinfo->waiters.size());
     napi_value result = nullptr;
-    NAPI_CALL_RETURN_VOID(
-        env, napi_create_string_utf8(env, asynccallbackinfo->oaid.c_str(), NAPI_AUTO_LENGTH, &result));
-    ReturnCallbackPromise(env, asynccallbackinfo, result);
-    NAPI_CALL_RETURN_VOID(env, napi_delete_async_work(env, asynccallbackinfo->asyncWork));
+    Cloud::OaidValue::FormatBuffer oaid;
+    asynccallbackinfo->oaid.Format(oaid);
+    if (napi_create_string_utf8(env, oaid.data(), Cloud::OaidValue::STRING_LENGTH, &result) != napi_ok) {
+        result = NapiGetNull(env);
+        asynccallbackinfo->errorCode = ERROR;
+    }
+    for (const auto &waiter : asynccallbackinfo->waiters) {
+        ReturnCallbackPromise(env, waiter, asynccallbackinfo->errorCode, result);
+    }
+    napi_delete_async_work(env, asynccallbackinfo->asyncWork);
     delete asynccallbackinfo;
     asynccallbackinfo = nullptr;
 }
 
-AsyncCallbackInfoOAID *GetAsyncCallbackInfoOAID(
-    napi_env &env, napi_callback_info &info, napi_ref &callback, napi_value &promise)
+napi_value GetOAID(napi_env env, napi_callback_info info)
 {
     size_t argc = OAID_MAX_PARA;
     napi_value argv[OAID_MAX_PARA] = {0};
     napi_value thisVar = nullptr;
     NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, NULL));
 
+    napi_ref callback = nullptr;
     if (ParseParameters(env, argv, argc, callback) == nullptr) {
-        return nullptr;
+        return ParaError(env, callback);
+    }
+
+    napi_value promise = nullptr;
+    OAIDWaiter waiter;
+    if (!PaddingWaiter(env, waiter, callback, promise)) {
+        return ParaError(env, callback);
+    }
+
+    std::lock_guard<std::mutex> lock(g_inflightOAIDMutex);
+    uint64_t resetEpoch = GetResetEpochLocked(env);
+    auto iter = g_inflightOAID.find(env);
+    if (iter != g_inflightOAID.end() && iter->second->resetEpoch == resetEpoch) {
+        iter->second->waiters.push_back(waiter);
+        return waiter.isCallback ? NapiGetNull(env) : promise;
     }
 
     AsyncCallbackInfoOAID *asynccallbackinfo =
-        new (std::nothrow) AsyncCallbackInfoOAID{.env = env, .asyncWork = nullptr};
-    if (!asynccallbackinfo) {
-        return nullptr;
+        new (std::nothrow) AsyncCallbackInfoOAID{.env = env, .resetEpoch = resetEpoch};
+    if (asynccallbackinfo == nullptr) {
+        SetPromiseOrCallbackError(env, waiter);
+        return waiter.isCallback ? NapiGetNull(env) : promise;
     }
+    asynccallbackinfo->waiters.push_back(waiter);
 
-    PaddingCallbackInfo(env, asynccallbackinfo, callback, promise);
-    return asynccallbackinfo;
+    napi_value resourceName = nullptr;
+    napi_create_string_utf8(env, "getAdsIdentifierInfo", NAPI_AUTO_LENGTH, &resourceName);
+    if (napi_create_async_work(env, nullptr, resourceName, GetOAIDExecuteCallBack, GetOAIDCompleteCallBack,
+        static_cast<void *>(asynccallbackinfo), &asynccallbackinfo->asyncWork) != napi_ok ||
+        napi_queue_async_work_with_qos(env, asynccallbackinfo->asyncWork, napi_qos_user_initiated) != napi_ok) {
+        OAID_HILOGE(OHOS::Cloud::OAID_MODULE_JS_NAPI, "queue getOAID async work failed");
+        if (asynccallbackinfo->asyncWork != nullptr) {
+            napi_delete_async_work(env, asynccallbackinfo->asyncWork);
+        }
+        delete asynccallbackinfo;
+        SetPromiseOrCallbackError(env, waiter);
+        return waiter.isCallback ? NapiGetNull(env) : promise;
+    }
+    // Replaces a fetch of an older epoch, that one still resolves its own waiters when it completes.
+    g_inflightOAID[env] = asynccallbackinfo;
+    return waiter.isCallback ? NapiGetNull(env) : promise;
 }
 
-napi_value GetOAID(napi_env env, napi_callback_info info)
+struct AsyncCallbackInfoResetOAID {
+    napi_env env = nullptr;
+    napi_async_work asyncWork = nullptr;
+    OAIDWaiter waiter;
+    int32_t errorCode = NO_ERROR;
+};
+
+const char *GetResetOAIDErrorMessage(int32_t errorCode)
 {
-    napi_ref callback = nullptr;
-    napi_value promise = nullptr;
-    AsyncCallbackInfoOAID *asynccallbackinfo = GetAsyncCallbackInfoOAID(env, info, callback, promise);
-    if (asynccallbackinfo == nullptr) {
-        return ParaError(env, callback);
+    switch (errorCode) {
+        case OAID_ERROR_CODE_NOT_SYSTEM_APP:
+            return "Permission verification failed. A non-system application calls a system API.";
+        case OAID_ERROR_NOT_IN_TRUST_LIST:
+            return "Not in the trust list";
+        case ERROR:
+            return "System internal error.";
+        default:
+            return nullptr;
     }
+}
 
-    napi_value resourceName = nullptr;
-    NAPI_CALL(env, napi_create_string_utf8(env, "getAdsIdentifierInfo", NAPI_AUTO_LENGTH, &resourceName));
-    napi_async_execute_callback getOAIDExecuteCallBack = GetOAIDExecuteCallBack;
-    napi_async_complete_callback getOAIDCompleteCallBack = GetOAIDCompleteCallBack;
-    NAPI_CALL(env,
-        napi_create_async_work(env,
-            nullptr,
-            resourceName,
-            getOAIDExecuteCallBack,
-            getOAIDCompleteCallBack,
-            static_cast<void *>(asynccallbackinfo),
-            &asynccallbackinfo->asyncWork));
-    NAPI_CALL(env, napi_queue_async_work_with_qos(env, asynccallbackinfo->asyncWork, napi_qos_user_initiated));
-
-    if (asynccallbackinfo->isCallback) {
-        return NapiGetNull(env);
+void ResetOAIDExecuteCallBack(napi_env env, void *data)
+{
+    AsyncCallbackInfoResetOAID *asynccallbackinfo = reinterpret_cast<AsyncCallbackInfoResetOAID *>(data);
+    asynccallbackinfo->errorCode = Cloud::OAIDServiceClient::GetInstance()->ResetOAID();
+    OAID_HILOGI(OHOS::Cloud::OAID_MODULE_JS_NAPI, "ResetOAID code = %{public}d", asynccallbackinfo->errorCode);
+}
+
+void ResetOAIDCompleteCallBack(napi_env env, napi_status status, void *data)
+{
+    AsyncCallbackInfoResetOAID *asynccallbackinfo = reinterpret_cast<AsyncCallbackInfoResetOAID *>(data);
+    // Fetches started while the reset was pending may have read the old OAID.
+    BumpResetEpoch(env);
+    const char *message = GetResetOAIDErrorMessage(asynccallbackinfo->errorCode);
+    // Only the codes with a message are failures, anything else keeps the previous "no throw" behaviour.
+    int32_t errorCode = (message == nullptr) ? NO_ERROR : asynccallbackinfo->errorCode;
+    napi_value undefined = nullptr;
+    napi_get_undefined(env, &undefined);
+    napi_value error = GetCallbackErrorValue(env, errorCode);
+    if (message != nullptr && error != nullptr) {
+        napi_value errorMessage = nullptr;
+        napi_create_string_utf8(env, message, NAPI_AUTO_LENGTH, &errorMessage);
+        napi_set_named_property(env, error, "message", errorMessage);
+    }
+    const OAIDWaiter &waiter = asynccallbackinfo->waiter;
+    if (waiter.isCallback) {
+        napi_value callback = nullptr;
+        napi_value resultout = nullptr;
+        napi_get_reference_value(env, waiter.callback, &callback);
+        napi_value results[CALLBACK_ARGS_LENGTH] = {error, undefined};
+        napi_call_function(env, undefined, callback, CALLBACK_ARGS_LENGTH, results, &resultout);
+        napi_delete_reference(env, waiter.callback);
     } else {
-        return promise;
+        SetPromise(env, waiter.deferred, errorCode, (errorCode == NO_ERROR) ? undefined : error);
     }
+    napi_delete_async_work(env, asynccallbackinfo->asyncWork);
+    delete asynccallbackinfo;
+    asynccallbackinfo = nullptr;
 }
 
 napi_value ResetOAID(napi_env env, napi_callback_info info)
@@ -225,25 +335,60 @@ napi_value ResetOAID(napi_env env, napi_callback_info info)
 
     napi_value result = nullptr;
     napi_get_undefined(env, &result);
+    BumpResetEpoch(env);
     int32_t errorCode = Cloud::OAIDServiceClient::GetInstance()->ResetOAID();
     OAID_HILOGI(OHOS::Cloud::OAID_MODULE_JS_NAPI, "ResetOAID code = %{public}d", errorCode);
-    if (errorCode == OAID_ERROR_CODE_NOT_SYSTEM_APP) {
-        napi_throw_error(env,
-            std::to_string(errorCode).c_str(),
-            "Permission verification failed. A non-system application calls a system API.");
+    const char *message = GetResetOAIDErrorMessage(errorCode);
+    if (message != nullptr) {
+        napi_throw_error(env, std::to_string(errorCode).c_str(), message);
     }
 
-    if (errorCode == OAID_ERROR_NOT_IN_TRUST_LIST) {
-        napi_throw_error(env, std::to_string(errorCode).c_str(), "Not in the trust list");
+    OAID_HILOGI(OHOS::Cloud::OAID_MODULE_JS_NAPI, "ResetOAID End.");
+
+    return result;
+}
+
+napi_value ResetOAIDAsync(napi_env env, napi_callback_info info)
+{
+    OAID_HILOGI(OHOS::Cloud::OAID_MODULE_JS_NAPI, "ResetOAIDAsync Begin.");
+    size_t argc = OAID_MAX_PARA;
+    napi_value argv[OAID_MAX_PARA] = {0};
+    napi_value thisVar = nullptr;
+    NAPI_CALL(env, napi_get_cb_info(env, info, &argc, argv, &thisVar, NULL));
+
+    napi_ref callback = nullptr;
+    if (ParseParameters(env, argv, argc, callback) == nullptr) {
+        return ParaError(env, callback);
     }
 
-    if (errorCode == ERROR) {
-        napi_throw_error(env, std::to_string(errorCode).c_str(), "System internal error.");
+    AsyncCallbackInfoResetOAID *asynccallbackinfo =
+        new (std::nothrow) AsyncCallbackInfoResetOAID{.env = env, .asyncWork = nullptr};
+    if (asynccallbackinfo == nullptr) {
+        return ParaError(env, callback);
+    }
+    napi_value promise = nullptr;
+    if (!PaddingWaiter(env, asynccallbackinfo->waiter, callback, promise)) {
+        delete asynccallbackinfo;
+        return ParaError(env, callback);
     }
+    BumpResetEpoch(env);
 
-    OAID_HILOGI(OHOS::Cloud::OAID_MODULE_JS_NAPI, "ResetOAID End.");
+    napi_value resourceName = nullptr;
+    napi_create_string_utf8(env, "resetOAIDAsync", NAPI_AUTO_LENGTH, &resourceName);
+    if (napi_create_async_work(env, nullptr, resourceName, ResetOAIDExecuteCallBack, ResetOAIDCompleteCallBack,
+        static_cast<void *>(asynccallbackinfo), &asynccallbackinfo->asyncWork) != napi_ok ||
+        napi_queue_async_work_with_qos(env, asynccallbackinfo->asyncWork, napi_qos_user_initiated) != napi_ok) {
+        OAID_HILOGE(OHOS::Cloud::OAID_MODULE_JS_NAPI, "queue resetOAIDAsync work failed");
+        if (asynccallbackinfo->asyncWork != nullptr) {
+            napi_delete_async_work(env, asynccallbackinfo->asyncWork);
+        }
+        OAIDWaiter waiter = asynccallbackinfo->waiter;
+        delete asynccallbackinfo;
+        SetPromiseOrCallbackError(env, waiter);
+        return waiter.isCallback ? NapiGetNull(env) : promise;
+    }
 
-    return result;
+    return asynccallbackinfo->waiter.isCallback ? NapiGetNull(env) : promise;
 }
 
 napi_value OAIDInit(napi_env env, napi_value exports)
@@ -251,6 +396,7 @@ napi_value OAIDInit(napi_env env, napi_value exports)
     napi_property_descriptor desc[] = {
         DECLARE_NAPI_FUNCTION("getOAID", GetOAID),
         DECLARE_NAPI_FUNCTION("resetOAID", ResetOAID),
+        DECLARE_NAPI_FUNCTION("resetOAIDAsync", ResetOAIDAsync),
     };
 
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc));
@@ -16,7 +16,11 @@
 #ifndef OHOS_CLOUD_BUNDLE_MGR_HELPER_H
 #define OHOS_CLOUD_BUNDLE_MGR_HELPER_H
 
+#include <list>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "bundle_mgr_interface.h"
@@ -48,19 +52,37 @@ public:
      */
     void ClearBundleMgrHelper();
 
+    /**
+     * Get bundle name by uid, served from the uid cache when possible.
+     */
     void GetBundleNameByUid(const int uid, std::string &name);
 
+    /**
+     * Drop the cached bundle name of the uid.
+     *
+     * @param uid App uid, a negative value drops the whole cache.
+     */
+    void InvalidateBundleNameCache(const int uid);
+
     bool GetBundleInfo(const std::string &bundleName, AppExecFwk::BundleInfo &bundleInfo,
         int32_t userId = AppExecFwk::Constants::UNSPECIFIED_USERID);
 
 private:
-    bool GetBundleMgrProxy();
+    sptr<IBundleMgr> GetBundleMgrProxy();
+    bool GetCachedBundleName(const int uid, std::string &name);
+    void PutCachedBundleName(const int uid, const std::string &name, uint64_t generation);
 
     sptr<AppExecFwk::IBundleMgr> bundleMgrProxy_;
-    std::mutex mutex_;
+    std::shared_mutex proxyMutex_;
     sptr<OAIDDeathRecipient> oaidDeathRecipient_;
+
+    using UidCacheList = std::list<std::pair<int, std::string>>;
+    std::mutex uidCacheMutex_;
+    UidCacheList uidCacheList_;
+    std::unordered_map<int, UidCacheList::iterator> uidCacheMap_;
+    uint64_t uidCacheGeneration_ = 0;
 };
 }  // namespace Cloud
 }  // namespace OHOS
 
-#endif  // OHOS_CLOUD_BUNDLE_MGR_HELPER_H
\ No newline at end of file
+#endif  // OHOS_CLOUD_BUNDLE_MGR_HELPER_H
@@ -28,6 +28,7 @@
 #include "message_option.h"
 #include "oaid_file_operator.h"
 #include "cJSON.h"
+#include <atomic>
 #include <mutex>
 #include <queue>
 #include <unordered_set>
@@ -97,6 +98,7 @@ public:
     int32_t DisconnectService();
     AAFwk::Want getWantInfo();
     bool checkAllowGetOaid();
+    void UpdateUnderAgePolicy(bool allowGetOaid, int64_t updateTime);
     void notifyKit(int32_t code);
     sptr<ConnectAdsStub> getConnection();
 
@@ -106,9 +108,17 @@ private:
     ConnectAdsManager(const ConnectAdsManager&) = delete;
     ConnectAdsManager& operator=(const ConnectAdsManager&) = delete;
 
+    uint64_t LoadUnderAgePolicy();
+    OaidStateStoreStatus MigrateLegacyUnderAgeState(bool &allowGetOaid, int64_t &updateTimestamp);
+
     static std::mutex connectMutex_;
     sptr<ConnectAdsStub> connectObject_;
     int32_t DEFAULT_VALUE = -1;
+    // Packed under-age decision: valid flag, allow flag and update time (ms), read with a single atomic load.
+    std::atomic<uint64_t> underAgePolicy_ {0};
+    // Set once the store gave an answer (a record or a confirmed absence), a failed read is retried.
+    std::atomic<bool> underAgePolicyLoaded_ {false};
+    std::mutex underAgePolicyMutex_;
 };
 
 } // namespace Cloud
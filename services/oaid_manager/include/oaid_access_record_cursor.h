@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_ACCESS_RECORD_CURSOR_H
+#define OHOS_CLOUD_OAID_ACCESS_RECORD_CURSOR_H
+
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace Cloud {
+/*
+ * Page cursor of GetAncoAccessRecords: "<first_time>,<uid length>,<uid><bundle name>". (first_time, bn, uid) is
+ * unique per user, a rowid would not survive a VACUUM.
+ */
+struct AccessRecordCursor {
+    int64_t firstTime = 0;
+    std::string bundleName;
+    std::string uid;
+};
+
+std::string EncodeAccessRecordCursor(int64_t firstTime, const std::string& bundleName, const std::string& uid);
+
+/**
+ * @return bool, false for a malformed cursor or an empty bundle name.
+ */
+bool DecodeAccessRecordCursor(const std::string& text, AccessRecordCursor& cursor);
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_ACCESS_RECORD_CURSOR_H
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_ACCESS_RECORD_JOURNAL_H
+#define OHOS_CLOUD_OAID_ACCESS_RECORD_JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace Cloud {
+struct AccessRecordEntry {
+    int32_t userId = 0;
+    std::string bundleName;
+    std::string uid;
+    int64_t time = 0;
+};
+
+/**
+ * Ring buffer of access records not yet committed to the RDB, kept in a memory mapped file so that records
+ * accepted before a crash or an unload are found again by the next Open. Each slot is a fixed size record
+ * with its own checksum, a slot torn by a crash is dropped on replay. Replay leaves the surviving records in
+ * place, so the window of pending sequences may hold such gaps until they are released.
+ */
+class OaidAccessRecordJournal {
+public:
+    static constexpr size_t MAX_BUNDLE_NAME_LENGTH = 200;
+    static constexpr size_t MAX_UID_LENGTH = 24;
+
+    OaidAccessRecordJournal() = default;
+    ~OaidAccessRecordJournal();
+    OaidAccessRecordJournal(const OaidAccessRecordJournal&) = delete;
+    OaidAccessRecordJournal& operator=(const OaidAccessRecordJournal&) = delete;
+
+    /**
+     * Map the journal file, replaying the records left by the previous process. Falls back to an anonymous
+     * mapping when the file can not be used, records are then only kept in memory.
+     *
+     * @param path Journal file path.
+     * @param capacity Number of record slots.
+     * @return Number of records recovered from the file.
+     */
+    size_t Open(const std::string &path, size_t capacity);
+
+    /**
+     * Append one record.
+     *
+     * @param entry Record.
+     * @param pendingCount Number of uncommitted records after the append.
+     * @return bool, false if the journal is not open, full, or the record does not fit a slot.
+     */
+    bool Append(const AccessRecordEntry &entry, size_t &pendingCount);
+
+    /**
+     * Copy up to maxCount of the oldest uncommitted records, they stay in the journal until Release.
+     */
+    size_t PeekBatch(std::vector<AccessRecordEntry> &batch, size_t maxCount);
+
+    /**
+     * Drop the count oldest records once they are committed.
+     */
+    void Release(size_t count);
+
+    size_t PendingCount();
+
+private:
+    struct Slot;
+
+    Slot *GetSlot(uint64_t sequence) const;
+    void CloseLocked();
+    bool MapFileLocked(const std::string &path, size_t mapSize);
+    bool IsIntactLocked(const Slot *slot) const;
+    size_t RecoverLocked();
+    void WriteSlotLocked(uint64_t sequence, const AccessRecordEntry &entry);
+
+    std::mutex mutex_;
+    uint8_t *base_ = nullptr;
+    size_t mapSize_ = 0;
+    size_t capacity_ = 0;
+    uint64_t head_ = 1;  // Sequence of the oldest uncommitted record, or of a gap before it.
+    uint64_t tail_ = 1;  // Sequence the next record gets.
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_ACCESS_RECORD_JOURNAL_H
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_CONFIG_MANAGER_H
+#define OHOS_CLOUD_OAID_CONFIG_MANAGER_H
+
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * Parsed content of oaid_service_config*.json.
+ */
+struct OaidServiceConfig {
+    bool hasResetTrustList = false;
+    std::unordered_set<std::string> resetOAIDBundleNames;
+    std::optional<std::string> providerBundleName;
+    std::optional<std::string> providerAbilityName;
+    std::optional<std::string> providerTokenName;
+    std::optional<std::string> stateStoreBackend;
+};
+
+/**
+ * Owns the service config file. The file is parsed once into an immutable snapshot which is
+ * re-parsed only when the resolved path, size or mtime of the file changes.
+ */
+class OaidConfigManager {
+public:
+    static OaidConfigManager& GetInstance();
+
+    /**
+     * Get the current config snapshot.
+     *
+     * @return Config snapshot, nullptr if the config file is missing or invalid.
+     */
+    std::shared_ptr<const OaidServiceConfig> GetConfig();
+
+    /**
+     * Check whether the bundle is allowed to reset the OAID.
+     *
+     * @param bundleName Caller bundle name.
+     * @return bool, true if the trust list is empty or contains the bundle.
+     */
+    bool IsInResetTrustList(const std::string &bundleName);
+
+private:
+    OaidConfigManager() = default;
+    ~OaidConfigManager() = default;
+    OaidConfigManager(const OaidConfigManager&) = delete;
+    OaidConfigManager& operator=(const OaidConfigManager&) = delete;
+
+    void RefreshConfig();
+    static bool ResolveConfigPath(std::string &realPath);
+    static std::shared_ptr<const OaidServiceConfig> ParseConfig(const std::string &content);
+
+    std::shared_ptr<const OaidServiceConfig> config_;
+    std::atomic<bool> loaded_ {false};
+    std::atomic<int64_t> nextCheckTime_ {0};
+    std::mutex reloadMutex_;
+    std::string configPath_;
+    off_t configSize_ = -1;
+    struct timespec configMtime_ {};
+};
+} // namespace Cloud
+} // namespace OHOS
+#endif // OHOS_CLOUD_OAID_CONFIG_MANAGER_H
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_FILE_STATE_STORE_H
+#define OHOS_CLOUD_OAID_FILE_STATE_STORE_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "oaid_state_store.h"
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * State store kept in a single local file. The file is mapped and parsed once, reads are served from memory,
+ * and every write rewrites a temporary file that is fsync'ed and renamed over the old one, so a crash leaves
+ * either the old or the new content. Until the file has been read, or found missing, reads report ERROR and
+ * writes fail, so a transient open failure never overwrites the stored entries.
+ */
+class OaidFileStateStore : public IOaidStateStore {
+public:
+    explicit OaidFileStateStore(const std::string &path);
+    ~OaidFileStateStore() override = default;
+
+    OaidStateStoreStatus Get(const std::string &key, std::vector<uint8_t> &value) override;
+    bool Put(const std::string &key, const std::vector<uint8_t> &value) override;
+    bool Delete(const std::string &key) override;
+
+private:
+    using EntryMap = std::map<std::string, std::vector<uint8_t>>;
+
+    bool LoadLocked();
+    // Move a malformed file out of the way, so the store can start empty without destroying it.
+    bool SetAsideLocked();
+    bool PersistLocked(const EntryMap &entries);
+    static bool ParseEntries(const uint8_t *data, size_t size, EntryMap &entries);
+    static void SerializeEntries(const EntryMap &entries, std::vector<uint8_t> &buffer);
+
+    std::string path_;
+    std::mutex mutex_;
+    bool loaded_ = false;
+    EntryMap entries_;
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_FILE_STATE_STORE_H
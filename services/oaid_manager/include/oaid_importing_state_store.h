@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_IMPORTING_STATE_STORE_H
+#define OHOS_CLOUD_OAID_IMPORTING_STATE_STORE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "oaid_state_store.h"
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * State store that, before its first access, copies the given keys from the store of the previously configured
+ * backend, so changing the backend keeps the OAID of the device. Only keys missing in the target are copied and a
+ * marker key is written once every key is settled; after that the source is never read again. Switching back and
+ * forth is not supported: values already in the target win over newer ones in the source.
+ */
+class OaidImportingStateStore : public IOaidStateStore {
+public:
+    OaidImportingStateStore(std::shared_ptr<IOaidStateStore> target, std::shared_ptr<IOaidStateStore> source,
+        std::vector<std::string> keys);
+    ~OaidImportingStateStore() override = default;
+
+    OaidStateStoreStatus Get(const std::string &key, std::vector<uint8_t> &value) override;
+    bool Put(const std::string &key, const std::vector<uint8_t> &value) override;
+    bool Delete(const std::string &key) override;
+
+private:
+    void EnsureImported();
+    bool ImportKey(const std::string &key);
+
+    std::shared_ptr<IOaidStateStore> target_;
+    std::shared_ptr<IOaidStateStore> source_;
+    std::vector<std::string> keys_;
+    std::mutex importMutex_;
+    bool importDone_ = false;
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_IMPORTING_STATE_STORE_H
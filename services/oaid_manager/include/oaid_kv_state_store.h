@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_KV_STATE_STORE_H
+#define OHOS_CLOUD_OAID_KV_STATE_STORE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "distributed_kv_data_manager.h"
+#include "oaid_state_store.h"
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * State store on a DistributedKv single version store. Opening the store is left to the owner, which
+ * hands in how to get it so the store can be warmed up and shared.
+ */
+class OaidKvStateStore : public IOaidStateStore {
+public:
+    using KvStoreGetter = std::function<std::shared_ptr<DistributedKv::SingleKvStore>()>;
+
+    OaidKvStateStore(const std::string &storeId, KvStoreGetter getter);
+    ~OaidKvStateStore() override = default;
+
+    OaidStateStoreStatus Get(const std::string &key, std::vector<uint8_t> &value) override;
+    bool Put(const std::string &key, const std::vector<uint8_t> &value) override;
+    bool Delete(const std::string &key) override;
+
+private:
+    std::string storeId_;
+    KvStoreGetter getter_;
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_KV_STATE_STORE_H
@@ -17,22 +17,46 @@
 #define OHOS_CLOUD_OAID_REMOTE_CONFIG_OBSERVER_MANAGER_H
 
 #include <shared_mutex>
+#include <vector>
 
 #include "singleton.h"
 #include "oaid_iremote_config_observer.h"
+#include "oaid_iremote_reset_listener.h"
+#include "oaid_value.h"
 
 namespace OHOS {
 namespace Cloud {
+class ResetListenerDeathRecipient : public IRemoteObject::DeathRecipient {
+public:
+    void OnRemoteDied(const wptr<IRemoteObject> &remote) override;
+};
+
 class OaidObserverManager {
     DECLARE_DELAYED_SINGLETON(OaidObserverManager)
 public:
     int32_t RegisterObserver(const sptr<IRemoteConfigObserver>& observer);
 
-    void OnUpdateOaid(const std::string& oaid);
+    void OnUpdateOaid(const OaidValue& oaid);
+
+    /**
+     * Register a listener of OAID resets, at most MAX_RESET_LISTENERS_PER_UID per calling uid.
+     */
+    int32_t RegisterResetListener(const sptr<IOaidResetListener>& listener, int32_t callingUid);
+
+    void RemoveResetListener(const wptr<IRemoteObject>& remote);
+
+    void NotifyResetListeners(uint64_t generation);
 
 private:
    sptr<IRemoteConfigObserver> observer_;
    std::shared_mutex observerMutex_;
+   struct ResetListenerEntry {
+       sptr<IOaidResetListener> listener;
+       int32_t uid;
+   };
+   std::vector<ResetListenerEntry> resetListeners_;
+   sptr<ResetListenerDeathRecipient> resetListenerDeathRecipient_;
+   std::mutex resetListenerMutex_;
 };
 } // namespace HaCloud
 } // namespace OHOS
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_PACKAGE_EVENT_SUBSCRIBER_H
+#define OHOS_CLOUD_OAID_PACKAGE_EVENT_SUBSCRIBER_H
+
+#include <memory>
+#include <mutex>
+
+#include "common_event_subscriber.h"
+
+namespace OHOS {
+namespace Cloud {
+class OaidPackageEventSubscriber : public EventFwk::CommonEventSubscriber {
+public:
+    explicit OaidPackageEventSubscriber(const EventFwk::CommonEventSubscribeInfo &subscribeInfo);
+    ~OaidPackageEventSubscriber() override = default;
+
+    /**
+     * Called back when a package add/remove/change or user removed event is received. Removals purge the anco
+     * records of the bundle or user in the background.
+     *
+     * @param data Indicates the common event data.
+     */
+    void OnReceiveEvent(const EventFwk::CommonEventData &data) override;
+
+    /**
+     * Subscribe the package events, called once the common event service is up.
+     */
+    static bool Subscribe();
+
+    static void Unsubscribe();
+
+private:
+    static std::mutex subscriberMutex_;
+    static std::shared_ptr<OaidPackageEventSubscriber> subscriber_;
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_PACKAGE_EVENT_SUBSCRIBER_H
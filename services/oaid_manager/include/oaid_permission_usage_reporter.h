@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_PERMISSION_USAGE_REPORTER_H
+#define OHOS_CLOUD_OAID_PERMISSION_USAGE_REPORTER_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "access_token.h"
+#include "event_handler.h"
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * Reports permission usage to the privacy service off the binder thread. Counts are aggregated per
+ * (token, permission) over a short window and flushed in one batch.
+ */
+class OaidPermissionUsageReporter {
+public:
+    static OaidPermissionUsageReporter& GetInstance();
+
+    /**
+     * Record one permission check, the record is reported when the current window is flushed.
+     *
+     * @param tokenId Caller token id.
+     * @param permissionName Checked permission.
+     * @param granted Whether the permission was granted.
+     */
+    void Report(Security::AccessToken::AccessTokenID tokenId, const std::string &permissionName, bool granted);
+
+    /**
+     * Report all pending records on the calling thread, used before the service is unloaded.
+     */
+    void Flush();
+
+private:
+    struct UsageCount {
+        int32_t successCount = 0;
+        int32_t failCount = 0;
+    };
+    using UsageKey = std::pair<Security::AccessToken::AccessTokenID, std::string>;
+
+    OaidPermissionUsageReporter() = default;
+    ~OaidPermissionUsageReporter() = default;
+    OaidPermissionUsageReporter(const OaidPermissionUsageReporter&) = delete;
+    OaidPermissionUsageReporter& operator=(const OaidPermissionUsageReporter&) = delete;
+
+    bool ScheduleFlushLocked();
+
+    std::mutex mutex_;
+    std::map<UsageKey, UsageCount> pending_;
+    uint64_t droppedCount_ = 0;
+    bool flushScheduled_ = false;
+    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_PERMISSION_USAGE_REPORTER_H
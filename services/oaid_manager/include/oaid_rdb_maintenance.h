@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_RDB_MAINTENANCE_H
+#define OHOS_CLOUD_OAID_RDB_MAINTENANCE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "event_handler.h"
+
+namespace OHOS {
+namespace Cloud {
+struct OaidRdbMaintenanceStats {
+    int64_t lastRunTimeMs = 0;  // Wall clock end of the last pass, 0 if no pass ran yet.
+    int64_t lastRunDurationMs = 0;
+    uint64_t lastRemovedRows = 0;
+    uint64_t totalRemovedRows = 0;
+    int64_t lastAnalyzeTimeMs = 0;
+    int64_t lastVacuumTimeMs = 0;
+};
+
+/**
+ * Background upkeep of the anco RDB on a LOW priority runner: reconciles uninstalled apps once per load, deletes
+ * expired access records in small chunks under a time budget, then runs ANALYZE / VACUUM when enough rows went
+ * away or the file is fragmented. The RDB lock is only held for one chunk at a time, queries interleave.
+ */
+class OaidRdbMaintenance {
+public:
+    static OaidRdbMaintenance& GetInstance();
+
+    /**
+     * Schedule the first pass shortly after the RDB is opened or the service is started again, later passes
+     * schedule themselves.
+     */
+    void Start();
+
+    /**
+     * Cancel the pending pass. Package events are not received while stopped, the next pass reconciles again.
+     */
+    void Stop();
+
+    /**
+     * Statistics of the last pass, printed by the service dump.
+     */
+    OaidRdbMaintenanceStats GetStats();
+
+private:
+    OaidRdbMaintenance() = default;
+    ~OaidRdbMaintenance() = default;
+    OaidRdbMaintenance(const OaidRdbMaintenance&) = delete;
+    OaidRdbMaintenance& operator=(const OaidRdbMaintenance&) = delete;
+
+    void Schedule(int64_t delayMs);
+    void RunPass();
+    // Returns false when the budget ran out before every expired row was deleted.
+    bool DeleteExpired(int64_t deadline, uint64_t& removed);
+    void CompactIfNeeded();
+
+    std::mutex mutex_;
+    std::shared_ptr<AppExecFwk::EventHandler> handler_;
+    bool scheduled_ = false;
+    bool stopped_ = false;
+    OaidRdbMaintenanceStats stats_;
+    std::atomic<bool> reconciled_ {false};  // Cleared by Stop.
+    uint64_t removedSinceAnalyze_ = 0;       // Only touched on the maintenance runner.
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_RDB_MAINTENANCE_H
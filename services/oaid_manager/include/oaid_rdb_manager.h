@@ -16,8 +16,10 @@
 #ifndef OHOS_CLOUD_OAID_RDB_MANAGER_H
 #define OHOS_CLOUD_OAID_RDB_MANAGER_H
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <vector>
@@ -31,6 +33,9 @@
 #include "value_object.h"
 #include "oaid_anco_service.h"
 #include "bundle_mgr_helper.h"
+#include "event_handler.h"
+#include "oaid_access_record_journal.h"
+#include "oaid_switch_status_cache.h"
 
 namespace OHOS {
 namespace Cloud {
@@ -41,27 +46,92 @@ public:
 
     int32_t Init();
 
+    /**
+     * Whether Init has completed, without opening the store.
+     */
+    bool IsReady() const;
+
     int32_t InsertOrReplaceSwitchStatus(int32_t userId,
         const std::string& bundleName, const std::string& uid, int32_t status);
 
+    /**
+     * Upsert all rows in one transaction, nothing is written if any row fails.
+     */
+    int32_t InsertOrReplaceSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos);
+
+    /**
+     * A lookup of one app is served from the in-memory table of the user, loaded from the RDB on first use.
+     */
     std::vector<AncoSwitchStatusInfo> QuerySwitchStatus(int32_t userId,
         const std::string& bundleName, const std::string& uid);
 
-    std::vector<AncoAccessRecordInfo> QueryAccessRecordsFromDatabase(int32_t userId, const std::string& bundleName,
-        const std::string& uid, int64_t sevenDaysAgo);
-
-    std::vector<AncoAccessRecordInfo> ProcessAccessRecords(const std::vector<AncoAccessRecordInfo>& records);
+    /**
+     * Look one app up in memory only, usable before Init.
+     *
+     * @return bool, false when the table of the user is not loaded yet.
+     */
+    bool QueryCachedSwitchStatus(int32_t userId, const std::string& bundleName, const std::string& uid,
+        std::vector<AncoSwitchStatusInfo>& result);
 
     std::vector<AncoAccessRecordInfo> QueryAccessRecords(int32_t userId, const std::string& bundleName,
         const std::string& uid);
 
+    /**
+     * Keyset paginated read of anco_a_minute, newest first. The cursor is the (first_time, bn, uid) key of the
+     * last row of the previous page, so a page costs one index seek however deep the caller has read.
+     *
+     * @return int32_t, ERR_INVALID_PARAM for a malformed cursor.
+     */
+    int32_t QueryAccessRecordsPage(int32_t userId, const std::string& bundleName, const std::string& uid,
+        const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page);
+
+    /**
+     * Journal one access record, it is committed to the RDB by the background flusher.
+     *
+     * @return int32_t, ERR_OK once the record is journaled.
+     */
     int32_t InsertAccessRecord(const int32_t userId, const std::string bundleName, const std::string uid);
 
+    /**
+     * Commit all journaled access records on the calling thread.
+     */
+    int32_t FlushAccessRecords();
+
     std::vector<std::string> QueryAllBundleNames(int32_t userId);
 
-    int32_t CleanUninstalledAppRecords(int32_t userId);
+    /**
+     * Drop the rows of an uninstalled bundle in the background, driven by the package removed event.
+     */
+    void SchedulePurgeBundle(int32_t userId, const std::string& bundleName);
+
+    /**
+     * Drop all rows of a removed user in the background, driven by the user removed event.
+     */
+    void SchedulePurgeUser(int32_t userId);
+
+    /**
+     * Catch up with the removals missed while the service was not running: the installed bundles of the user
+     * are fetched with one BMS call and every tracked bundle not among them is purged.
+     */
+    int32_t ReconcileUninstalledAppRecords(int32_t userId);
 
-    int32_t CleanExpiredAccessRecords(int32_t userId);
+    std::vector<int32_t> QueryAllUserIds();
+
+    /**
+     * Delete one chunk of the user's access records older than cutoffMs, from both the raw table and the rollup.
+     *
+     * @param limit Rows deleted per table at most.
+     * @param deleted Rows deleted.
+     * @param hasMore Whether expired rows may remain.
+     */
+    int32_t DeleteExpiredAccessRecords(int32_t userId, int64_t cutoffMs, size_t limit, size_t& deleted,
+        bool& hasMore);
+
+    int32_t GetPageCounts(int64_t& pageCount, int64_t& freelistCount);
+
+    int32_t Vacuum();
+
+    int32_t Analyze();
 private:
     OaidRdbManager() = default;
     ~OaidRdbManager();
@@ -70,9 +140,39 @@ private:
         const std::string& tableColumns, const std::string& primaryKey = "");
 
     class OaidRdbOpenCallback;
+    // Writers take it exclusively, readers shared: the store has one write connection and a pool of WAL readers.
     mutable std::shared_mutex mutex_;
+    // Set once the store is open and the journal replayed, so Init costs an atomic load afterwards.
+    std::atomic<bool> ready_ {false};
     std::shared_ptr<NativeRdb::RdbStore> rdbStore_;
 
+    int32_t OpenStoreLocked();
+    int UpsertSwitchStatusLocked(const AncoSwitchStatusInfo& info, int64_t currentTime);
+    // Load the table of the user into switchStatusCache_, the caller holds mutex_.
+    bool LoadSwitchStatusLocked(int32_t userId);
+    int32_t InsertAccessRecordDirectly(const AccessRecordEntry& entry);
+    // Insert the raw row and merge it into anco_a_minute, the caller holds mutex_ inside a transaction.
+    int InsertAccessRecordLocked(const AccessRecordEntry& entry);
+    // Both need flushMutex_ and the exclusive lock held.
+    int32_t FlushAccessRecordsLocked();
+    int32_t CommitAccessRecordsLocked(const std::vector<AccessRecordEntry>& batch);
+    void ScheduleAccessRecordFlush(bool immediate);
+    std::shared_ptr<AppExecFwk::EventHandler> GetWorkHandler();
+    int32_t PurgeBundleRecords(int32_t userId, const std::vector<std::string>& bundleNames);
+    int32_t PurgeUserRecords(int32_t userId);
+
+    // Updated under the exclusive mutex_ after each committed write to anco_s_status.
+    OaidSwitchStatusCache switchStatusCache_;
+    OaidAccessRecordJournal journal_;
+    // Serializes flushes, so a batch is never committed twice.
+    std::mutex flushMutex_;
+    std::mutex flushTaskMutex_;
+    bool flushScheduled_ = false;
+    bool flushImmediate_ = false;
+    // Background runner of the flushes and purges.
+    std::mutex workHandlerMutex_;
+    std::shared_ptr<AppExecFwk::EventHandler> workHandler_;
+
     std::pair<std::string, std::vector<NativeRdb::ValueObject>> BuildBatchDeleteSql(int32_t userId,
         const std::string& tableName, const std::vector<std::string>& bundleNames);
 };
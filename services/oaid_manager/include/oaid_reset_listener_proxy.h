@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_RESET_LISTENER_PROXY_H
+#define OHOS_CLOUD_OAID_RESET_LISTENER_PROXY_H
+
+#include "iremote_proxy.h"
+#include "oaid_iremote_reset_listener.h"
+
+namespace OHOS {
+namespace Cloud {
+class OaidResetListenerProxy : public IRemoteProxy<IOaidResetListener> {
+public:
+    explicit OaidResetListenerProxy(const sptr<IRemoteObject>& impl);
+    virtual ~OaidResetListenerProxy() override = default;
+
+    void OnOaidReset(uint64_t generation) override;
+
+private:
+    static inline BrokerDelegator<OaidResetListenerProxy> delegator_;
+};
+} // namespace Cloud
+} // namespace OHOS
+#endif // OHOS_CLOUD_OAID_RESET_LISTENER_PROXY_H
@@ -16,8 +16,12 @@
 #ifndef OHOS_CLOUD_OAID_SERVICES_H
 #define OHOS_CLOUD_OAID_SERVICES_H
 
+#include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "iremote_proxy.h"
@@ -25,6 +29,7 @@
 #include "securec.h"
 #include "system_ability.h"
 #include "oaid_service_stub.h"
+#include "oaid_state_store.h"
 
 namespace OHOS {
 namespace Cloud {
@@ -44,9 +49,10 @@ public:
     /**
      * Get OAID
      *
-     * @return std::string, OAID.
+     * @param generation OAID generation the returned value belongs to.
+     * @return OaidValue, OAID.
      */
-    std::string GetOAID() override;
+    OaidValue GetOAID(uint64_t &generation) override;
 
     /**
      * Reset open advertising id.
@@ -65,6 +71,8 @@ public:
     bool SetAncoSwitchStatus(int32_t userId, const std::string& bundleName,
         const std::string& uid, int32_t status) override;
 
+    bool SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos) override;
+
     /**
      * Get anco switch status for lake app.
      *
@@ -86,32 +94,101 @@ public:
      */
     std::vector<AncoAccessRecordInfo> GetAncoAccessRecords(int32_t userId,
         const std::string& bundleName, const std::string& uid) override;
+    int32_t GetAncoAccessRecordsPage(int32_t userId, const std::string& bundleName, const std::string& uid,
+        const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page) override;
     std::string GetAncoOAID() override;
     int32_t InsertAccessRecord(const int32_t userId, const std::string bundleName, const std::string uid) override;
 
-    bool ReadValueFromUnderAgeKvStore(const std::string &kvStoreKey, DistributedKv::Value &kvStoreValue);
+    /**
+     * Advance the OAID generation and push it to the registered reset listeners, called whenever the
+     * OAID seen by apps changes (reset or under age policy change).
+     */
+    static void NotifyOaidChanged();
+
+    OaidStateStoreStatus ReadValueFromUnderAgeKvStore(const std::string &kvStoreKey,
+        DistributedKv::Value &kvStoreValue);
     bool WriteValueToUnderAgeKvStore(const std::string &kvStoreKey, const DistributedKv::Value &kvStoreValue);
+    bool DeleteValueFromUnderAgeKvStore(const std::string &kvStoreKey);
+
+    /**
+     * hidumper entry, prints the state store backend and the RDB maintenance statistics.
+     */
+    int Dump(int fd, const std::vector<std::u16string> &args) override;
 protected:
     void OnStart() override;
     void OnStop() override;
     void OnAddSystemAbility(int32_t systemAbilityId, const std::string& deviceId) override;
 private:
+    enum class KvStoreState { NOT_READY, OPENING, READY, FAILED };
+    struct KvStoreSlot {
+        std::shared_ptr<DistributedKv::SingleKvStore> store;
+        KvStoreState state = KvStoreState::NOT_READY;
+    };
+
     int32_t Init();
-    bool CheckKvStore();
-    bool ReadValueFromKvStore(const std::string &kvStoreKey, std::string &kvStoreValue);
+    /**
+     * Backend of the state stores: the advertising_oaid_state_store_backend build default, overridden by the
+     * "stateStoreBackend" item of the service config. Chosen once per process.
+     */
+    static OaidStateStoreBackend GetStateStoreBackend();
+    static void InitStateStores();
+    static std::shared_ptr<IOaidStateStore> GetStateStore(const std::string &storeId);
+    OaidStateStoreStatus ReadValueFromKvStore(const std::string &kvStoreKey, std::string &kvStoreValue);
     bool WriteValueToKvStore(const std::string &kvStoreKey, const std::string &kvStoreValue);
-    bool CheckUnderAgeKvStore();
-    std::string GainOAID();
+
+    /**
+     * Open both kv stores in parallel on background threads, retrying with exponential backoff.
+     */
+    static void StartKvStoreWarmUp();
+    static void StopKvStoreWarmUp();
+    static void WarmUpKvStore(const std::string &storeId);
+    static DistributedKv::Status OpenKvStore(const std::string &storeId,
+        std::shared_ptr<DistributedKv::SingleKvStore> &kvStore);
+
+    /**
+     * Get an opened kv store. Waits at most KVSTORE_READY_WAIT_TIMEOUT_MS for the warm-up, and only makes a
+     * single open attempt itself when no warm-up is running.
+     *
+     * @param storeId Kv store id.
+     * @return Kv store, nullptr if it is not ready.
+     */
+    static std::shared_ptr<DistributedKv::SingleKvStore> AcquireKvStore(const std::string &storeId);
+    static KvStoreSlot &GetKvStoreSlot(const std::string &storeId);
+    static void PublishKvStoreLocked(const std::string &storeId,
+        const std::shared_ptr<DistributedKv::SingleKvStore> &kvStore);
+    OaidValue GainOAID();
+    OaidValue LoadOrCreateOAID();
+    /**
+     * Publish the snapshot served by GainOAID without re-reading the store. Only called with a value read from
+     * the store, or written to it (generated on NOT_FOUND, or reset with its write queued in order).
+     */
+    void PublishOAID(const OaidValue &oaid);
+    void PostPersistOAIDTask(const OaidValue &oaid);
+    void WaitPersistOAIDTasks();
 
     ServiceRunningState state_;
     static std::mutex mutex_;
     static sptr<OAIDService> instance_;
     static std::atomic<bool> oaidKvStoreExist;
 
-    std::shared_ptr<DistributedKv::SingleKvStore> oaidKvStore_;
-    std::shared_ptr<DistributedKv::SingleKvStore> oaidUnderAgeKvStore_;
-    std::mutex updateMutex_;
-    std::string oaid_;
+    static std::once_flag stateStoreOnce_;
+    static OaidStateStoreBackend stateStoreBackend_;
+    static std::shared_ptr<IOaidStateStore> oaidStateStore_;
+    static std::shared_ptr<IOaidStateStore> underAgeStateStore_;
+    // Kv stores are shared by the registered SA and GetInstance(), guarded by kvStoreMutex_.
+    static std::mutex kvStoreMutex_;
+    static std::condition_variable kvStoreCond_;
+    static KvStoreSlot oaidKvStoreSlot_;
+    static KvStoreSlot underAgeKvStoreSlot_;
+    static bool kvWarmUpStopping_;
+    static std::vector<std::thread> kvWarmUpThreads_;
+    // Immutable OAID snapshot, published atomically so GET_OAID never takes a lock once it is loaded.
+    static std::shared_ptr<const OaidValue> oaidSnapshot_;
+    // Bumped after every change of the OAID seen by apps, lets client caches reject stale replies.
+    static std::atomic<uint64_t> oaidGeneration_;
+    static std::mutex updateMutex_;
+    static std::mutex persistHandlerMutex_;
+    static std::shared_ptr<AppExecFwk::EventHandler> persistHandler_;
 };
 } // namespace Cloud
 } // namespace OHOS
@@ -31,7 +31,9 @@ static const int32_t OAID_SYSTME_ID = 6101;
 
 /* communication settings define */
 static constexpr uint32_t KVSTORE_CONNECT_RETRY_COUNT = 5;
-static constexpr uint32_t KVSTORE_CONNECT_RETRY_DELAY_TIME = 3000;  // Unit: ms
+static constexpr uint32_t KVSTORE_WARM_UP_INITIAL_BACKOFF_MS = 50;
+static constexpr uint32_t KVSTORE_WARM_UP_MAX_BACKOFF_MS = 1600;
+static constexpr int64_t KVSTORE_READY_WAIT_TIMEOUT_MS = 2000;
 static const int8_t CONNECT_TIME_OUT = 3;                           // The connection timeout is 3s.
 
 /* not system app error code */
@@ -59,6 +61,8 @@ static const std::string OAID_UNDER_AGE_STORE_ID = "underAgeInfo";
 static const std::string OAID_KVSTORE_KEY = "oaid_key";
 static const std::string ALLOW_GET_OAID_KEY = "ALLOW_GET_OAID_KEY";
 static const std::string LAST_UPDATE_TIME_KEY = "ALLOW_GET_OAID_UPDATE_KEY";
+/* Versioned binary record replacing ALLOW_GET_OAID_KEY and LAST_UPDATE_TIME_KEY. */
+static const std::string UNDER_AGE_STATE_KEY = "UNDER_AGE_STATE_KEY";
 static const std::string OAID_TRUSTLIST_CONFIG_PATH = "/etc/advertising/oaid/oaid_service_config.json";
 static const std::string OAID_TRUSTLIST_EXTENSION_CONFIG_PATH = "/etc/advertising/oaid/oaid_service_config_ext.json";
 
@@ -16,9 +16,11 @@
 #ifndef OHOS_CLOUD_OAID_SERVICE_STUB_H
 #define OHOS_CLOUD_OAID_SERVICE_STUB_H
 
+#include <atomic>
 #include <fstream>
 #include <vector>
 #include <map>
+#include <mutex>
 #include <string>
 #include <pthread.h>
 #include "cJSON.h"
@@ -49,26 +51,79 @@ public:
 
     int32_t RegisterObserver(const sptr<IRemoteConfigObserver>& observer) override;
 
+    int32_t RegisterResetListener(const sptr<IOaidResetListener>& listener) override;
+
 private:
-    int32_t OnGetOAID(MessageParcel& data, MessageParcel& reply);
-    int32_t OnResetOAID(MessageParcel& data, MessageParcel& reply);
-    int32_t SendCode(uint32_t code, MessageParcel &data, MessageParcel &reply);
-    int32_t HandleRegisterControlConfigObserver(MessageParcel& data, MessageParcel& reply);
-    int32_t OnSetAncoSwitchStatus(MessageParcel& data, MessageParcel& reply);
-    int32_t OnGetAncoSwitchStatus(MessageParcel& data, MessageParcel& reply);
-    int32_t OnGetAncoAccessRecords(MessageParcel& data, MessageParcel& reply);
-    int32_t OnInsertAccessRecord(MessageParcel& data, MessageParcel& reply);
-    int32_t OnGetAncoOAID(MessageParcel& data, MessageParcel& reply);
+    /** Permission check run before a code's handler. */
+    enum class CallerPolicy : uint8_t {
+        APP_TRACKING_PERMISSION,
+        RESET_TRUST_LIST,
+        HA_UID,
+        PRIVACY_HAP_OR_BROKER,
+        PRIVACY_HAP,
+        BROKER_SA,
+    };
+
+    /** Caller attributes a code needs, resolved lazily and at most once. */
+    enum CallerAttr : uint8_t {
+        CALLER_ATTR_NONE = 0,
+        CALLER_ATTR_BUNDLE_NAME = 1 << 0,
+    };
+
+    class CallerInfo {
+    public:
+        CallerInfo(pid_t uid, uint8_t attrs) : uid_(uid), attrs_(attrs) {}
+        pid_t GetUid() const
+        {
+            return uid_;
+        }
+        const std::string &GetBundleName();
+
+    private:
+        pid_t uid_;
+        uint8_t attrs_;
+        bool bundleNameResolved_ = false;
+        std::string bundleName_;
+    };
+
+    using CodeHandler = int32_t (OAIDServiceStub::*)(MessageParcel &, MessageParcel &, CallerInfo &);
+
+    struct CodeEntry {
+        uint32_t code;
+        CodeHandler handler;
+        CallerPolicy policy;
+        uint8_t attrs;
+    };
+
+    static const CodeEntry *FindCodeEntry(uint32_t code);
+    int32_t CheckCallerPolicy(const CodeEntry &entry, CallerInfo &caller, MessageParcel &reply);
+    int32_t OnGetOAID(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t OnResetOAID(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t HandleRegisterControlConfigObserver(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t HandleRegisterResetListener(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t OnSetAncoSwitchStatus(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t OnSetAncoSwitchStatusBatch(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t OnGetAncoSwitchStatus(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t OnGetAncoAccessRecords(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t OnGetAncoAccessRecordsPage(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t OnInsertAccessRecord(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
+    int32_t OnGetAncoOAID(MessageParcel& data, MessageParcel& reply, CallerInfo& caller);
     bool CheckPermission(const std::string &permissionName);
     bool CheckSystemApp();
     bool CheckSecurityPrivacyHap();
     void ExitIdleState();
-    void checkProviderBundleName();
-    void PostDelayUnloadTask();
-    int32_t ValidateResetOAIDPermission(std::string bundleName, MessageParcel &reply);
+    void RecordActivity();
+    void ArmIdleTimer(int64_t delayMs);
+    void CheckIdle();
+    void checkProviderBundleName(CallerInfo &caller);
+    int32_t ValidateResetOAIDPermission(const std::string &bundleName, MessageParcel &reply);
     bool CheckBrokerSA();
     std::shared_ptr<AppExecFwk::EventHandler> unloadHandler_;
-    std::mutex init_eventHandler_Mutex_;
+    std::once_flag unloadHandlerOnce_;
+    std::atomic<int64_t> lastActivityTime_ {0};
+    std::atomic<bool> idleTimerArmed_ {false};
+    std::atomic<bool> unloadRequested_ {false};
+    std::atomic<uint64_t> samgrCallsSaved_ {0};
 };
 } // namespace Cloud
 } // namespace OHOS
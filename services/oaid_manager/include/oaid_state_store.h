@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_STATE_STORE_H
+#define OHOS_CLOUD_OAID_STATE_STORE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace Cloud {
+enum class OaidStateStoreBackend { KV, FILE };
+
+/**
+ * Result of a read. NOT_FOUND is a confirmed absence, ERROR means the store could not answer and the read
+ * may be retried.
+ */
+enum class OaidStateStoreStatus { SUCCESS, NOT_FOUND, ERROR };
+
+/**
+ * Key value storage behind the OAID and under age state of OAIDService.
+ */
+class IOaidStateStore {
+public:
+    virtual ~IOaidStateStore() = default;
+
+    /**
+     * Read the value of key.
+     *
+     * @param key Key.
+     * @param value Value read.
+     * @return OaidStateStoreStatus, SUCCESS if value was read.
+     */
+    virtual OaidStateStoreStatus Get(const std::string &key, std::vector<uint8_t> &value) = 0;
+
+    /**
+     * Write the value of key, the value is durable once true is returned.
+     */
+    virtual bool Put(const std::string &key, const std::vector<uint8_t> &value) = 0;
+
+    /**
+     * Delete key, deleting a missing key succeeds.
+     */
+    virtual bool Delete(const std::string &key) = 0;
+};
+
+/**
+ * Parse a backend name: "kv" or "file".
+ *
+ * @param name Backend name.
+ * @param backend Parsed backend.
+ * @return bool, false if name is unknown.
+ */
+bool ParseOaidStateStoreBackend(const std::string &name, OaidStateStoreBackend &backend);
+
+const char *GetOaidStateStoreBackendName(OaidStateStoreBackend backend);
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_STATE_STORE_H
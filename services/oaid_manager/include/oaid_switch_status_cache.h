@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_SWITCH_STATUS_CACHE_H
+#define OHOS_CLOUD_OAID_SWITCH_STATUS_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "oaid_anco_service.h"
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * In-memory copy of anco_s_status, one table per user loaded on first use. A loaded table holds every row of
+ * the user, so a missing entry means no record without asking the RDB. Writers update it while they still
+ * hold the RDB exclusive lock, which keeps it in step with the table. Users are spread over lock shards, so a
+ * write or a load of one user does not stall the lookups of another.
+ */
+class OaidSwitchStatusCache {
+public:
+    enum class LookupResult {
+        NOT_LOADED,
+        FOUND,
+        ABSENT,
+    };
+
+    LookupResult Lookup(int32_t userId, const std::string &bundleName, const std::string &uid, int32_t &status);
+
+    bool IsLoaded(int32_t userId);
+
+    /**
+     * Replace the table of the user with all its rows.
+     */
+    void LoadUser(int32_t userId, const std::vector<AncoSwitchStatusInfo> &rows);
+
+    /**
+     * Apply a committed write, ignored while the user is not loaded: the next load reads it from the RDB.
+     */
+    void Put(const AncoSwitchStatusInfo &info);
+
+    void EraseBundles(int32_t userId, const std::vector<std::string> &bundleNames);
+
+    void EraseUser(int32_t userId);
+
+private:
+    using UidStatusMap = std::unordered_map<std::string, int32_t>;
+    using UserTable = std::unordered_map<std::string, UidStatusMap>;  // bundle name -> uid -> status
+
+    static constexpr size_t SHARD_COUNT = 8;
+
+    struct Shard {
+        std::shared_mutex mutex;
+        std::unordered_map<int32_t, UserTable> users;
+    };
+
+    Shard &GetShard(int32_t userId);
+
+    std::array<Shard, SHARD_COUNT> shards_;
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_SWITCH_STATUS_CACHE_H
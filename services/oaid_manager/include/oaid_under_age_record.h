@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_UNDER_AGE_RECORD_H
+#define OHOS_CLOUD_OAID_UNDER_AGE_RECORD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OHOS {
+namespace Cloud {
+/*
+ * Under age record stored under UNDER_AGE_STATE_KEY, little endian:
+ * byte 0 version, byte 1 allow flag, bytes 2..9 update time (ms).
+ */
+constexpr uint8_t UNDER_AGE_RECORD_VERSION = 1;
+constexpr size_t UNDER_AGE_RECORD_ALLOW_OFFSET = 1;
+constexpr size_t UNDER_AGE_RECORD_TIME_OFFSET = 2;
+constexpr size_t UNDER_AGE_RECORD_SIZE = UNDER_AGE_RECORD_TIME_OFFSET + sizeof(int64_t);
+
+std::vector<uint8_t> EncodeUnderAgeRecord(bool allowGetOaid, int64_t updateTime);
+
+/**
+ * Decode a record written by this or a newer version.
+ *
+ * @return bool, false if the record is too short or its version is unknown.
+ */
+bool DecodeUnderAgeRecord(const std::vector<uint8_t> &record, bool &allowGetOaid, int64_t &updateTime);
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_UNDER_AGE_RECORD_H
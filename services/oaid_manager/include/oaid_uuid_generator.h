@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_UUID_GENERATOR_H
+#define OHOS_CLOUD_OAID_UUID_GENERATOR_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+#include "oaid_value.h"
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * Generates random (version 4) UUIDs from a pre-filled CSPRNG buffer, so most calls only copy 16 bytes.
+ * The buffer is refilled in one RAND_bytes call when drained and the DRBG is reseeded periodically.
+ */
+class OaidUuidGenerator {
+public:
+    static OaidUuidGenerator& GetInstance();
+
+    /**
+     * Generate one v4 UUID.
+     *
+     * @param value Generated UUID.
+     * @return bool, false if the CSPRNG failed, value is left untouched then.
+     */
+    bool Generate(OaidValue &value);
+
+private:
+    static constexpr size_t UUIDS_PER_REFILL = 64;
+    static constexpr size_t BUFFER_SIZE = UUIDS_PER_REFILL * OaidValue::BYTE_SIZE;
+
+    OaidUuidGenerator() = default;
+    ~OaidUuidGenerator();
+    OaidUuidGenerator(const OaidUuidGenerator&) = delete;
+    OaidUuidGenerator& operator=(const OaidUuidGenerator&) = delete;
+
+    bool RefillLocked();
+
+    std::mutex mutex_;
+    std::array<uint8_t, BUFFER_SIZE> buffer_ {};
+    size_t offset_ = BUFFER_SIZE;
+    uint32_t refillCount_ = 0;
+};
+}  // namespace Cloud
+}  // namespace OHOS
+#endif  // OHOS_CLOUD_OAID_UUID_GENERATOR_H
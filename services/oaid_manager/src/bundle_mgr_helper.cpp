@@ -24,62 +24,73 @@
 
 namespace OHOS {
 namespace Cloud {
+namespace {
+constexpr size_t UID_CACHE_CAPACITY = 128;
+}  // namespace
+
 BundleMgrHelper::BundleMgrHelper() : bundleMgrProxy_(nullptr), oaidDeathRecipient_(nullptr)
 {}
 
 BundleMgrHelper::~BundleMgrHelper()
 {}
 
-bool BundleMgrHelper::GetBundleMgrProxy()
+sptr<AppExecFwk::IBundleMgr> BundleMgrHelper::GetBundleMgrProxy()
 {
-    OAID_HILOGI(OAID_MODULE_SERVICE, "GetBundleMgrProxy");
-
-    if (!bundleMgrProxy_) {
-        sptr<ISystemAbilityManager> systemAbilityManager =
-            SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
-        if (!systemAbilityManager) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to get system ability mgr.");
-            return false;
+    {
+        std::shared_lock<std::shared_mutex> readLock(proxyMutex_);
+        if (bundleMgrProxy_ != nullptr) {
+            return bundleMgrProxy_;
         }
+    }
 
-        sptr<IRemoteObject> remoteObject =
-            systemAbilityManager->GetSystemAbility(BUNDLE_MGR_SERVICE_SYS_ABILITY_ID);
-        if (!remoteObject) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to get bundle manager service.");
-            return false;
-        }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "GetBundleMgrProxy");
+    std::unique_lock<std::shared_mutex> writeLock(proxyMutex_);
+    if (bundleMgrProxy_ != nullptr) {
+        return bundleMgrProxy_;
+    }
+    sptr<ISystemAbilityManager> systemAbilityManager =
+        SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (!systemAbilityManager) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to get system ability mgr.");
+        return nullptr;
+    }
 
-        bundleMgrProxy_ = iface_cast<IBundleMgr>(remoteObject);
-        if ((!bundleMgrProxy_) || (!bundleMgrProxy_->AsObject())) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to get system bundle manager services ability");
-            return false;
-        }
+    sptr<IRemoteObject> remoteObject =
+        systemAbilityManager->GetSystemAbility(BUNDLE_MGR_SERVICE_SYS_ABILITY_ID);
+    if (!remoteObject) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to get bundle manager service.");
+        return nullptr;
+    }
 
-        oaidDeathRecipient_ = new (std::nothrow) OAIDDeathRecipient();
-        if (!oaidDeathRecipient_) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to create death Recipient ptr OAIDDeathRecipient");
-            return false;
-        }
-        if (!bundleMgrProxy_->AsObject()->AddDeathRecipient(oaidDeathRecipient_)) {
-            OAID_HILOGW(OAID_MODULE_SERVICE, "Failed to add death recipient");
-        }
+    sptr<IBundleMgr> bundleMgrProxy = iface_cast<IBundleMgr>(remoteObject);
+    if ((!bundleMgrProxy) || (!bundleMgrProxy->AsObject())) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to get system bundle manager services ability");
+        return nullptr;
     }
 
-    return true;
+    oaidDeathRecipient_ = new (std::nothrow) OAIDDeathRecipient();
+    if (!oaidDeathRecipient_) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to create death Recipient ptr OAIDDeathRecipient");
+        return nullptr;
+    }
+    if (!bundleMgrProxy->AsObject()->AddDeathRecipient(oaidDeathRecipient_)) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Failed to add death recipient");
+    }
+    bundleMgrProxy_ = bundleMgrProxy;
+    return bundleMgrProxy_;
 }
 
 bool BundleMgrHelper::GetBundleInfosV9ByReqPermission(std::vector<AppExecFwk::BundleInfo> &bundleInfos, int32_t userId)
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "GetBundleInfosV9ByReqPermission");
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!GetBundleMgrProxy()) {
+    sptr<IBundleMgr> bundleMgrProxy = GetBundleMgrProxy();
+    if (bundleMgrProxy == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "get BundleMgr Proxy fail");
         return false;
     }
 
     int32_t flag = static_cast<int32_t>(AppExecFwk::GetBundleInfoFlag::GET_BUNDLE_INFO_WITH_REQUESTED_PERMISSION);
-    ErrCode ret = bundleMgrProxy_->GetBundleInfosV9(flag, bundleInfos, userId);
+    ErrCode ret = bundleMgrProxy->GetBundleInfosV9(flag, bundleInfos, userId);
     if (ret != ERR_OK) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to getBundleInfos");
         return false;
@@ -92,16 +103,15 @@ bool BundleMgrHelper::GetApplicationInfoV9WithPermission(
     const std::string bundleName, int32_t userId, AppExecFwk::ApplicationInfo &applicationInfo)
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "GetApplicationInfoV9ByReqPermission");
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!GetBundleMgrProxy()) {
+    sptr<IBundleMgr> bundleMgrProxy = GetBundleMgrProxy();
+    if (bundleMgrProxy == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "get BundleMgr Proxy fail");
         return false;
     }
 
     int32_t applicationFlag =
         static_cast<int32_t>(AppExecFwk::GetApplicationFlag::GET_APPLICATION_INFO_WITH_PERMISSION);
-    ErrCode ret = bundleMgrProxy_->GetApplicationInfoV9(bundleName, applicationFlag, userId, applicationInfo);
+    ErrCode ret = bundleMgrProxy->GetApplicationInfoV9(bundleName, applicationFlag, userId, applicationInfo);
     if (ret != ERR_OK) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to GetApplicationInfoV9");
         return false;
@@ -110,20 +120,78 @@ bool BundleMgrHelper::GetApplicationInfoV9WithPermission(
     return true;
 }
 
+bool BundleMgrHelper::GetCachedBundleName(const int uid, std::string &name)
+{
+    std::lock_guard<std::mutex> lock(uidCacheMutex_);
+    auto iter = uidCacheMap_.find(uid);
+    if (iter == uidCacheMap_.end()) {
+        return false;
+    }
+    uidCacheList_.splice(uidCacheList_.begin(), uidCacheList_, iter->second);
+    name = iter->second->second;
+    return true;
+}
+
+void BundleMgrHelper::PutCachedBundleName(const int uid, const std::string &name, uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(uidCacheMutex_);
+    // An invalidation raced with the BMS lookup, the result may already be stale.
+    if (generation != uidCacheGeneration_) {
+        return;
+    }
+    auto iter = uidCacheMap_.find(uid);
+    if (iter != uidCacheMap_.end()) {
+        iter->second->second = name;
+        uidCacheList_.splice(uidCacheList_.begin(), uidCacheList_, iter->second);
+        return;
+    }
+    if (uidCacheList_.size() >= UID_CACHE_CAPACITY) {
+        uidCacheMap_.erase(uidCacheList_.back().first);
+        uidCacheList_.pop_back();
+    }
+    uidCacheList_.emplace_front(uid, name);
+    uidCacheMap_[uid] = uidCacheList_.begin();
+}
+
+void BundleMgrHelper::InvalidateBundleNameCache(const int uid)
+{
+    std::lock_guard<std::mutex> lock(uidCacheMutex_);
+    uidCacheGeneration_++;
+    if (uid < 0) {
+        uidCacheMap_.clear();
+        uidCacheList_.clear();
+        return;
+    }
+    auto iter = uidCacheMap_.find(uid);
+    if (iter != uidCacheMap_.end()) {
+        uidCacheList_.erase(iter->second);
+        uidCacheMap_.erase(iter);
+    }
+}
+
 void BundleMgrHelper::GetBundleNameByUid(const int uid, std::string &name)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    if (GetCachedBundleName(uid, name)) {
+        return;
+    }
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> lock(uidCacheMutex_);
+        generation = uidCacheGeneration_;
+    }
 
-    if (!GetBundleMgrProxy()) {
+    sptr<IBundleMgr> bundleMgrProxy = GetBundleMgrProxy();
+    if (bundleMgrProxy == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "get BundleMgr Proxy fail");
         return;
     }
 
-    ErrCode ret = bundleMgrProxy_->GetNameForUid(uid, name);
+    ErrCode ret = bundleMgrProxy->GetNameForUid(uid, name);
     if (ret != ERR_OK) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to GetNameForUid");
         return;
     }
+    PutCachedBundleName(uid, name, generation);
     OAID_HILOGI(OAID_MODULE_SERVICE, "GetBundleNameByUid success");
     return;
 }
@@ -132,16 +200,15 @@ bool BundleMgrHelper::GetBundleInfo(const std::string &bundleName, AppExecFwk::B
     int32_t userId)
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "GetBundleInfo");
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!GetBundleMgrProxy()) {
+    sptr<IBundleMgr> bundleMgrProxy = GetBundleMgrProxy();
+    if (bundleMgrProxy == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "get BundleMgr Proxy fail");
         return false;
     }
 
     int32_t bundleFlag =
         static_cast<int32_t>(AppExecFwk::GetBundleInfoFlag::GET_BUNDLE_INFO_DEFAULT);
-    ErrCode ret = bundleMgrProxy_->GetBundleInfoV9(bundleName, bundleFlag, bundleInfo, userId);
+    ErrCode ret = bundleMgrProxy->GetBundleInfoV9(bundleName, bundleFlag, bundleInfo, userId);
     if (ret != ERR_OK) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to GetBundleInfo");
         return false;
@@ -153,7 +220,7 @@ bool BundleMgrHelper::GetBundleInfo(const std::string &bundleName, AppExecFwk::B
 void BundleMgrHelper::ClearBundleMgrHelper()
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "ClearBundleMgrHelper");
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::shared_mutex> lock(proxyMutex_);
 
     if ((bundleMgrProxy_ != nullptr) && (bundleMgrProxy_->AsObject() != nullptr)) {
         bundleMgrProxy_->AsObject()->RemoveDeathRecipient(oaidDeathRecipient_);
@@ -161,4 +228,4 @@ void BundleMgrHelper::ClearBundleMgrHelper()
     bundleMgrProxy_ = nullptr;
 }
 }  // namespace Cloud
-}  // namespace OHOS
\ No newline at end of file
+}  // namespace OHOS
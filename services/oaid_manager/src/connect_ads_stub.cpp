@@ -14,8 +14,10 @@
  */
 
 #include "connect_ads_stub.h"
-#include <fstream>
+#include "oaid_config_manager.h"
+#include "oaid_under_age_record.h"
 #include <charconv>
+#include <cinttypes>
 
 namespace OHOS {
 namespace Cloud {
@@ -38,6 +40,31 @@ std::mutex ConnectAdsStub::proxyMutex_;
 std::mutex ConnectAdsManager::connectMutex_;
 std::int32_t ConnectAdsStub::CODE_OAID = GET_ALLOW_OAID_CODE;
 
+namespace {
+constexpr uint64_t UNDER_AGE_POLICY_VALID_BIT = 1ULL << 63;
+constexpr uint64_t UNDER_AGE_POLICY_ALLOW_BIT = 1ULL << 62;
+constexpr uint64_t UNDER_AGE_POLICY_TIME_MASK = UNDER_AGE_POLICY_ALLOW_BIT - 1;
+const std::string ALLOW_GET_OAID_TRUE = "true";
+
+uint64_t PackUnderAgePolicy(bool allowGetOaid, int64_t updateTime)
+{
+    uint64_t policy = UNDER_AGE_POLICY_VALID_BIT;
+    if (allowGetOaid) {
+        policy |= UNDER_AGE_POLICY_ALLOW_BIT;
+    }
+    if (updateTime > 0) {
+        policy |= static_cast<uint64_t>(updateTime) & UNDER_AGE_POLICY_TIME_MASK;
+    }
+    return policy;
+}
+
+bool ParseTimestamp(const std::string &timeStr, int64_t &timestamp)
+{
+    auto [ptr, ec] = std::from_chars(timeStr.data(), timeStr.data() + timeStr.size(), timestamp);
+    return ec == std::errc() && ptr == timeStr.data() + timeStr.size();
+}
+}  // namespace
+
 // ConnectAdsStub 实现
 void ConnectAdsStub::OnAbilityConnectDone(const ElementName &element,
     const sptr<IRemoteObject> &remoteObject, int resultCode)
@@ -217,102 +244,132 @@ Want ConnectAdsManager::getWantInfo()
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "enter getWantInfo ");
     Want connectionWant;
-    char pathBuff[PATH_MAX] = {0};
-    GetOneCfgFile(OAID_TRUSTLIST_EXTENSION_CONFIG_PATH.c_str(), pathBuff, PATH_MAX);
-    char realPath[PATH_MAX] = {0};
-    if (realpath(pathBuff, realPath) == nullptr) {
-        GetOneCfgFile(OAID_TRUSTLIST_CONFIG_PATH.c_str(), pathBuff, PATH_MAX);
-        if (realpath(pathBuff, realPath) == nullptr) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Parse realpath fail");
-            return connectionWant;
-        }
-    }
-    std::ifstream inFile(realPath, std::ios::in);
-    if (!inFile.is_open()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Open file error.");
+    auto config = OaidConfigManager::GetInstance().GetConfig();
+    if (config == nullptr) {
         return connectionWant;
     }
-    std::string fileContent((std::istreambuf_iterator<char>{inFile}), std::istreambuf_iterator<char>{});
-    cJSON *root = cJSON_Parse(fileContent.c_str());
-    inFile.close();
-    if (root == nullptr) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "ParseJsonFromFile is not in JSON format.");
-        return connectionWant;
-    }
-    cJSON *oaidProviderBundleNameConfig = cJSON_GetObjectItem(root, "providerBundleName");
-    if (oaidProviderBundleNameConfig == nullptr || oaidProviderBundleNameConfig->type != cJSON_String) {
+    if (!config->providerBundleName.has_value()) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "not contain providerBundleName node.");
-        cJSON_Delete(root);
         return connectionWant;
     }
-    cJSON *oaidProviderAbilityNameConfig = cJSON_GetObjectItem(root, "providerAbilityName");
-    if (oaidProviderAbilityNameConfig == nullptr || oaidProviderAbilityNameConfig->type != cJSON_String) {
+    if (!config->providerAbilityName.has_value()) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "not contain providerAbilityName node.");
-        cJSON_Delete(root);
         return connectionWant;
     }
-    cJSON *oaidProviderTokenNameConfig = cJSON_GetObjectItem(root, "providerTokenName");
-    if (oaidProviderTokenNameConfig == nullptr || oaidProviderTokenNameConfig->type != cJSON_String
-        || oaidProviderTokenNameConfig->valuestring == nullptr) {
+    if (!config->providerTokenName.has_value()) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "not contain providerTokenName node.");
-        cJSON_Delete(root);
         return connectionWant;
     }
-    ConnectAdsStub::setToken(Str8ToStr16(oaidProviderTokenNameConfig->valuestring));
-    connectionWant.SetElementName(oaidProviderBundleNameConfig->valuestring,
-        oaidProviderAbilityNameConfig->valuestring);
-    cJSON_Delete(root);
+    ConnectAdsStub::setToken(Str8ToStr16(config->providerTokenName.value()));
+    connectionWant.SetElementName(config->providerBundleName.value(), config->providerAbilityName.value());
     return connectionWant;
 }
 
-bool ConnectAdsManager::checkAllowGetOaid()
+uint64_t ConnectAdsManager::LoadUnderAgePolicy()
 {
-    DistributedKv::Value allowGetOaid;
-    DistributedKv::Value updateTime;
-    bool readAllowResult = OAIDService::GetInstance()->ReadValueFromUnderAgeKvStore(ALLOW_GET_OAID_KEY, allowGetOaid);
-    bool readTimeResult = OAIDService::GetInstance()->ReadValueFromUnderAgeKvStore(LAST_UPDATE_TIME_KEY, updateTime);
-    if (!readAllowResult || !readTimeResult) {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "checkAllowGetOaid get kvData failed");
-        ConnectAdsManager::GetInstance()->notifyKit(GET_ALLOW_OAID_CODE);
-        return true;
+    std::lock_guard<std::mutex> lock(underAgePolicyMutex_);
+    if (underAgePolicyLoaded_.load(std::memory_order_acquire)) {
+        return underAgePolicy_.load(std::memory_order_acquire);
     }
-    if (allowGetOaid.Empty() || updateTime.Empty()) {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "checkAllowGetOaid kvData is empty");
-        ConnectAdsManager::GetInstance()->notifyKit(GET_ALLOW_OAID_CODE);
-        return true;
+    bool allowGetOaid = true;
+    int64_t updateTimestamp = 0;
+    DistributedKv::Value record;
+    OaidStateStoreStatus status = OAIDService::GetInstance()->ReadValueFromUnderAgeKvStore(UNDER_AGE_STATE_KEY,
+        record);
+    if (status == OaidStateStoreStatus::SUCCESS) {
+        if (!DecodeUnderAgeRecord(record.Data(), allowGetOaid, updateTimestamp)) {
+            // Rereading cannot fix a malformed record, the kit refreshes it.
+            OAID_HILOGE(OAID_MODULE_SERVICE, "LoadUnderAgePolicy record is malformed, size=%{public}zu",
+                record.Size());
+            underAgePolicyLoaded_.store(true, std::memory_order_release);
+            return underAgePolicy_.load(std::memory_order_acquire);
+        }
+    } else if (status == OaidStateStoreStatus::NOT_FOUND) {
+        status = MigrateLegacyUnderAgeState(allowGetOaid, updateTimestamp);
     }
-    std::string updateTimeStr = updateTime.ToString();
-    long long updateTimestamp = 0;
-    // 使用 std::from_chars 转换字符串为 long long
-    auto [ptr, ec] = std::from_chars(
-        updateTimeStr.data(),
-        updateTimeStr.data() + updateTimeStr.size(),
-        updateTimestamp);
-    // 检查转换是否成功
-    if (ec != std::errc() || ptr != updateTimeStr.data() + updateTimeStr.size()) {
+    // 读失败时不置位，下次调用重新读取，避免漏掉已存储的未成年人拒绝策略
+    if (status == OaidStateStoreStatus::ERROR) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "LoadUnderAgePolicy read failed, retry on next call");
+        return underAgePolicy_.load(std::memory_order_acquire);
+    }
+    underAgePolicyLoaded_.store(true, std::memory_order_release);
+    if (status == OaidStateStoreStatus::NOT_FOUND) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "LoadUnderAgePolicy kvData is empty");
+        return underAgePolicy_.load(std::memory_order_acquire);
+    }
+    // A callback from the kit may have filled the cache while the store was being read; it wins.
+    uint64_t expected = 0;
+    underAgePolicy_.compare_exchange_strong(expected, PackUnderAgePolicy(allowGetOaid, updateTimestamp),
+        std::memory_order_acq_rel);
+    return underAgePolicy_.load(std::memory_order_acquire);
+}
+
+OaidStateStoreStatus ConnectAdsManager::MigrateLegacyUnderAgeState(bool &allowGetOaid, int64_t &updateTimestamp)
+{
+    DistributedKv::Value legacyAllow;
+    DistributedKv::Value legacyTime;
+    OaidStateStoreStatus allowStatus =
+        OAIDService::GetInstance()->ReadValueFromUnderAgeKvStore(ALLOW_GET_OAID_KEY, legacyAllow);
+    OaidStateStoreStatus timeStatus =
+        OAIDService::GetInstance()->ReadValueFromUnderAgeKvStore(LAST_UPDATE_TIME_KEY, legacyTime);
+    if (allowStatus == OaidStateStoreStatus::ERROR || timeStatus == OaidStateStoreStatus::ERROR) {
+        return OaidStateStoreStatus::ERROR;
+    }
+    if (allowStatus != OaidStateStoreStatus::SUCCESS || timeStatus != OaidStateStoreStatus::SUCCESS ||
+        legacyAllow.Empty() || legacyTime.Empty()) {
+        return OaidStateStoreStatus::NOT_FOUND;
+    }
+    if (!ParseTimestamp(legacyTime.ToString(), updateTimestamp)) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to convert timestamp: invalid or out of range");
+        return OaidStateStoreStatus::NOT_FOUND;
+    }
+    allowGetOaid = legacyAllow.ToString() == ALLOW_GET_OAID_TRUE;
+    // 旧的两个key只迁移一次，新记录写入成功后再删除
+    if (!OAIDService::GetInstance()->WriteValueToUnderAgeKvStore(UNDER_AGE_STATE_KEY,
+        DistributedKv::Value(EncodeUnderAgeRecord(allowGetOaid, updateTimestamp)))) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Migrate under age state failed, keep legacy keys");
+        return OaidStateStoreStatus::SUCCESS;
+    }
+    OAIDService::GetInstance()->DeleteValueFromUnderAgeKvStore(ALLOW_GET_OAID_KEY);
+    OAIDService::GetInstance()->DeleteValueFromUnderAgeKvStore(LAST_UPDATE_TIME_KEY);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Migrate under age state success");
+    return OaidStateStoreStatus::SUCCESS;
+}
+
+void ConnectAdsManager::UpdateUnderAgePolicy(bool allowGetOaid, int64_t updateTime)
+{
+    uint64_t oldPolicy = underAgePolicy_.exchange(PackUnderAgePolicy(allowGetOaid, updateTime),
+        std::memory_order_acq_rel);
+    // A missing policy is treated as allowed by checkAllowGetOaid.
+    bool oldAllow = (oldPolicy & UNDER_AGE_POLICY_VALID_BIT) == 0 || (oldPolicy & UNDER_AGE_POLICY_ALLOW_BIT) != 0;
+    if (oldAllow != allowGetOaid) {
+        OAIDService::NotifyOaidChanged();
+    }
+}
+
+bool ConnectAdsManager::checkAllowGetOaid()
+{
+    uint64_t policy = underAgePolicy_.load(std::memory_order_acquire);
+    if ((policy & UNDER_AGE_POLICY_VALID_BIT) == 0) {
+        policy = LoadUnderAgePolicy();
+    }
+    if ((policy & UNDER_AGE_POLICY_VALID_BIT) == 0) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "checkAllowGetOaid policy is empty");
+        notifyKit(GET_ALLOW_OAID_CODE);
         return true;
     }
-    long long nowTimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+    int64_t updateTimestamp = static_cast<int64_t>(policy & UNDER_AGE_POLICY_TIME_MASK);
+    int64_t nowTimestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     if (nowTimestamp < updateTimestamp) {
         OAID_HILOGW(OAID_MODULE_SERVICE, "user time illegal");
-    } else {
-        long long interval = nowTimestamp - updateTimestamp;
+    } else if (nowTimestamp - updateTimestamp >= EXPIRATION_TIME) {
         OAID_HILOGI(OAID_MODULE_SERVICE,
-            "checkAllowGetOaid now = %{public}lld  updateTime = %{public}s  interval = %{public}lld, ",
-            nowTimestamp,
-            updateTimeStr.c_str(),
-            interval);
-        if (interval >= EXPIRATION_TIME) {
-            ConnectAdsManager::GetInstance()->notifyKit(GET_ALLOW_OAID_CODE);
-        }
-    }
-    if (allowGetOaid.ToString() == "true") {
-        return true;
-    } else {
-        return false;
+            "checkAllowGetOaid expired, now = %{public}" PRId64 " updateTime = %{public}" PRId64,
+            nowTimestamp, updateTimestamp);
+        notifyKit(GET_ALLOW_OAID_CODE);
     }
+    return (policy & UNDER_AGE_POLICY_ALLOW_BIT) != 0;
 }
 
 int ADSCallbackStub::OnRemoteRequest(uint32_t code, MessageParcel& data, MessageParcel& reply, MessageOption& option)
@@ -329,14 +386,19 @@ int ADSCallbackStub::OnRemoteRequest(uint32_t code, MessageParcel& data, Message
         ConnectAdsManager::GetInstance()->DisconnectService();
         return ERR_OK;
     }
-    DistributedKv::Value value1(isAllowGetOaid);
-    DistributedKv::Value value2(updateTimeStr);
-    bool allowGetOaidResult = OAIDService::GetInstance()->WriteValueToUnderAgeKvStore(ALLOW_GET_OAID_KEY, value1);
-    bool lastUpdateTimeResult = OAIDService::GetInstance()->WriteValueToUnderAgeKvStore(LAST_UPDATE_TIME_KEY, value2);
-    OAID_HILOGI(OAID_MODULE_SERVICE,
-        "OnRemoteRequest Write AllowGetOaid result=%{public}s.OnRemoteRequest Write lastUpdateTime result=%{public}s",
-        allowGetOaidResult == true ? "success" : "failed",
-        lastUpdateTimeResult == true ? "success" : "failed");
+    int64_t updateTimestamp = 0;
+    if (!ParseTimestamp(updateTimeStr, updateTimestamp)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "OnRemoteRequest invalid updateTime, under age state not updated");
+        ConnectAdsManager::GetInstance()->DisconnectService();
+        return ERR_OK;
+    }
+    bool allowGetOaid = isAllowGetOaid == ALLOW_GET_OAID_TRUE;
+    ConnectAdsManager::GetInstance()->UpdateUnderAgePolicy(allowGetOaid, updateTimestamp);
+    // Flag and time go into one record with one put, a reader never sees one without the other.
+    bool writeResult = OAIDService::GetInstance()->WriteValueToUnderAgeKvStore(UNDER_AGE_STATE_KEY,
+        DistributedKv::Value(EncodeUnderAgeRecord(allowGetOaid, updateTimestamp)));
+    OAID_HILOGI(OAID_MODULE_SERVICE, "OnRemoteRequest Write under age state result=%{public}s",
+        writeResult == true ? "success" : "failed");
     ConnectAdsManager::GetInstance()->DisconnectService();
     return ERR_OK;
 }
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_access_record_cursor.h"
+
+#include <charconv>
+
+namespace OHOS {
+namespace Cloud {
+std::string EncodeAccessRecordCursor(int64_t firstTime, const std::string& bundleName, const std::string& uid)
+{
+    return std::to_string(firstTime) + "," + std::to_string(uid.size()) + "," + uid + bundleName;
+}
+
+bool DecodeAccessRecordCursor(const std::string& text, AccessRecordCursor& cursor)
+{
+    const char* begin = text.data();
+    const char* end = text.data() + text.size();
+    auto [timeEnd, timeErr] = std::from_chars(begin, end, cursor.firstTime);
+    if (timeErr != std::errc() || timeEnd == end || *timeEnd != ',') {
+        return false;
+    }
+    size_t uidLength = 0;
+    auto [lengthEnd, lengthErr] = std::from_chars(timeEnd + 1, end, uidLength);
+    if (lengthErr != std::errc() || lengthEnd == end || *lengthEnd != ',' ||
+        static_cast<size_t>(end - lengthEnd - 1) <= uidLength) {
+        return false;
+    }
+    cursor.uid.assign(lengthEnd + 1, uidLength);
+    cursor.bundleName.assign(lengthEnd + 1 + uidLength, end);
+    return true;
+}
+}  // namespace Cloud
+}  // namespace OHOS
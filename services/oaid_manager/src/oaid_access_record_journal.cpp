@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_access_record_journal.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+
+#include "oaid_common.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+constexpr uint32_t JOURNAL_MAGIC = 0x4A52414F;  // "OARJ"
+constexpr uint32_t JOURNAL_VERSION = 1;
+constexpr uint32_t FNV_OFFSET_BASIS = 2166136261U;
+constexpr uint32_t FNV_PRIME = 16777619U;
+constexpr mode_t JOURNAL_FILE_MODE = 0600;
+
+struct JournalHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    uint32_t slotSize;
+};
+
+uint32_t Checksum(const uint8_t *data, size_t size)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+}  // namespace
+
+// One record per slot, the first slot sized block of the mapping holds the JournalHeader.
+struct OaidAccessRecordJournal::Slot {
+    uint64_t sequence;  // 0 for a free slot.
+    int64_t time;
+    int32_t userId;
+    uint16_t bundleNameLength;
+    uint16_t uidLength;
+    char bundleName[MAX_BUNDLE_NAME_LENGTH];
+    char uid[MAX_UID_LENGTH];
+    uint32_t checksum;  // Over all the bytes before it.
+    uint32_t reserved;
+};
+
+namespace {
+constexpr size_t SLOT_SIZE = 256;
+}  // namespace
+static_assert(sizeof(JournalHeader) <= SLOT_SIZE, "journal header must fit one slot");
+
+OaidAccessRecordJournal::~OaidAccessRecordJournal()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    CloseLocked();
+}
+
+size_t OaidAccessRecordJournal::Open(const std::string &path, size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (base_ != nullptr || capacity == 0) {
+        return 0;
+    }
+    size_t mapSize = SLOT_SIZE * (capacity + 1);
+    capacity_ = capacity;
+    size_t recovered = 0;
+    if (MapFileLocked(path, mapSize)) {
+        const JournalHeader *header = reinterpret_cast<const JournalHeader *>(base_);
+        if (header->magic == JOURNAL_MAGIC && header->version == JOURNAL_VERSION &&
+            header->capacity == capacity && header->slotSize == SLOT_SIZE) {
+            recovered = RecoverLocked();
+        } else {
+            if (header->magic != 0) {
+                OAID_HILOGW(OAID_MODULE_SERVICE, "Access record journal layout changed, discard it");
+            }
+            (void)memset(base_, 0, mapSize_);
+            JournalHeader newHeader = { JOURNAL_MAGIC, JOURNAL_VERSION, static_cast<uint32_t>(capacity), SLOT_SIZE };
+            (void)memcpy(base_, &newHeader, sizeof(newHeader));
+        }
+        msync(base_, mapSize_, MS_ASYNC);
+    } else {
+        void *addr = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (addr == MAP_FAILED) {
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Map access record buffer failed, errno=%{public}d", errno);
+            capacity_ = 0;
+            return 0;
+        }
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Access record journal unavailable, records are kept in memory only");
+        base_ = static_cast<uint8_t *>(addr);
+        mapSize_ = mapSize;
+    }
+    if (recovered > 0) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "Replay %{public}zu access records from journal", recovered);
+    }
+    return recovered;
+}
+
+bool OaidAccessRecordJournal::MapFileLocked(const std::string &path, size_t mapSize)
+{
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, JOURNAL_FILE_MODE);
+    if (fd < 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Open access record journal failed, errno=%{public}d", errno);
+        return false;
+    }
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) != 0 ||
+        (static_cast<size_t>(fileStat.st_size) != mapSize && ftruncate(fd, static_cast<off_t>(mapSize)) != 0)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Size access record journal failed, errno=%{public}d", errno);
+        close(fd);
+        return false;
+    }
+    void *addr = mmap(nullptr, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Map access record journal failed, errno=%{public}d", errno);
+        return false;
+    }
+    base_ = static_cast<uint8_t *>(addr);
+    mapSize_ = mapSize;
+    return true;
+}
+
+void OaidAccessRecordJournal::CloseLocked()
+{
+    if (base_ != nullptr) {
+        msync(base_, mapSize_, MS_SYNC);
+        munmap(base_, mapSize_);
+        base_ = nullptr;
+    }
+    mapSize_ = 0;
+    capacity_ = 0;
+    head_ = 1;
+    tail_ = 1;
+}
+
+OaidAccessRecordJournal::Slot *OaidAccessRecordJournal::GetSlot(uint64_t sequence) const
+{
+    static_assert(sizeof(Slot) == SLOT_SIZE, "journal slot layout changed");
+    return reinterpret_cast<Slot *>(base_ + SLOT_SIZE * (1 + sequence % capacity_));
+}
+
+bool OaidAccessRecordJournal::IsIntactLocked(const Slot *slot) const
+{
+    return slot->bundleNameLength <= MAX_BUNDLE_NAME_LENGTH && slot->uidLength <= MAX_UID_LENGTH &&
+        slot->checksum == Checksum(reinterpret_cast<const uint8_t *>(slot), offsetof(Slot, checksum));
+}
+
+size_t OaidAccessRecordJournal::RecoverLocked()
+{
+    // The records stay in their slots: rewriting them would put the only copy at risk if the process dies
+    // again before the rewrite is done. Only torn slots and slots outside the ring window are cleared.
+    uint64_t maxSequence = 0;
+    for (size_t i = 0; i < capacity_; i++) {
+        Slot *slot = reinterpret_cast<Slot *>(base_ + SLOT_SIZE * (1 + i));
+        if (slot->sequence == 0) {
+            continue;
+        }
+        if (!IsIntactLocked(slot) || GetSlot(slot->sequence) != slot) {
+            (void)memset(slot, 0, SLOT_SIZE);
+            continue;
+        }
+        maxSequence = std::max(maxSequence, slot->sequence);
+    }
+    head_ = 1;
+    tail_ = 1;
+    if (maxSequence == 0) {
+        return 0;
+    }
+    uint64_t minSequence = maxSequence;
+    size_t count = 0;
+    for (size_t i = 0; i < capacity_; i++) {
+        Slot *slot = reinterpret_cast<Slot *>(base_ + SLOT_SIZE * (1 + i));
+        if (slot->sequence == 0) {
+            continue;
+        }
+        if (slot->sequence + capacity_ <= maxSequence) {
+            (void)memset(slot, 0, SLOT_SIZE);
+            continue;
+        }
+        minSequence = std::min(minSequence, slot->sequence);
+        count++;
+    }
+    head_ = minSequence;
+    tail_ = maxSequence + 1;
+    return count;
+}
+
+void OaidAccessRecordJournal::WriteSlotLocked(uint64_t sequence, const AccessRecordEntry &entry)
+{
+    Slot slot {};
+    slot.sequence = sequence;
+    slot.time = entry.time;
+    slot.userId = entry.userId;
+    slot.bundleNameLength = static_cast<uint16_t>(entry.bundleName.size());
+    slot.uidLength = static_cast<uint16_t>(entry.uid.size());
+    (void)memcpy(slot.bundleName, entry.bundleName.data(), entry.bundleName.size());
+    (void)memcpy(slot.uid, entry.uid.data(), entry.uid.size());
+    slot.checksum = Checksum(reinterpret_cast<const uint8_t *>(&slot), offsetof(Slot, checksum));
+    (void)memcpy(GetSlot(sequence), &slot, sizeof(slot));
+}
+
+bool OaidAccessRecordJournal::Append(const AccessRecordEntry &entry, size_t &pendingCount)
+{
+    if (entry.bundleName.size() > MAX_BUNDLE_NAME_LENGTH || entry.uid.size() > MAX_UID_LENGTH) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (base_ == nullptr || tail_ - head_ >= capacity_) {
+        return false;
+    }
+    WriteSlotLocked(tail_++, entry);
+    pendingCount = static_cast<size_t>(tail_ - head_);
+    return true;
+}
+
+size_t OaidAccessRecordJournal::PeekBatch(std::vector<AccessRecordEntry> &batch, size_t maxCount)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch.clear();
+    if (base_ == nullptr) {
+        return 0;
+    }
+    batch.reserve(std::min<uint64_t>(tail_ - head_, maxCount));
+    for (uint64_t sequence = head_; sequence < tail_ && batch.size() < maxCount; sequence++) {
+        const Slot *slot = GetSlot(sequence);
+        if (slot->sequence != sequence) {
+            continue;  // Torn by a crash and cleared on replay.
+        }
+        AccessRecordEntry entry;
+        entry.userId = slot->userId;
+        entry.bundleName.assign(slot->bundleName, slot->bundleNameLength);
+        entry.uid.assign(slot->uid, slot->uidLength);
+        entry.time = slot->time;
+        batch.push_back(std::move(entry));
+    }
+    return batch.size();
+}
+
+void OaidAccessRecordJournal::Release(size_t count)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (base_ == nullptr) {
+        return;
+    }
+    while (head_ < tail_ && (count > 0 || GetSlot(head_)->sequence != head_)) {
+        Slot *slot = GetSlot(head_);
+        if (slot->sequence == head_) {
+            count--;
+        }
+        (void)memset(slot, 0, SLOT_SIZE);
+        head_++;
+    }
+}
+
+size_t OaidAccessRecordJournal::PendingCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<size_t>(tail_ - head_);
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_config_manager.h"
+
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <sys/stat.h>
+
+#include "cJSON.h"
+#include "config_policy_utils.h"
+#include "oaid_common.h"
+#include "oaid_service_define.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+constexpr int64_t CONFIG_CHECK_INTERVAL_MS = 5000;
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::optional<std::string> GetStringItem(const cJSON *root, const char *name)
+{
+    cJSON *item = cJSON_GetObjectItem(root, name);
+    if (item == nullptr || !cJSON_IsString(item) || item->valuestring == nullptr) {
+        return std::nullopt;
+    }
+    return std::string(item->valuestring);
+}
+}  // namespace
+
+OaidConfigManager& OaidConfigManager::GetInstance()
+{
+    static OaidConfigManager instance;
+    return instance;
+}
+
+std::shared_ptr<const OaidServiceConfig> OaidConfigManager::GetConfig()
+{
+    int64_t now = GetSteadyTimeMs();
+    if (!loaded_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(reloadMutex_);
+        if (!loaded_.load(std::memory_order_relaxed)) {
+            RefreshConfig();
+            nextCheckTime_.store(now + CONFIG_CHECK_INTERVAL_MS, std::memory_order_relaxed);
+            loaded_.store(true, std::memory_order_release);
+        }
+    } else if (now >= nextCheckTime_.load(std::memory_order_relaxed)) {
+        // Only one thread re-checks the file; the others keep using the current snapshot.
+        std::unique_lock<std::mutex> lock(reloadMutex_, std::try_to_lock);
+        if (lock.owns_lock()) {
+            RefreshConfig();
+            nextCheckTime_.store(now + CONFIG_CHECK_INTERVAL_MS, std::memory_order_relaxed);
+        }
+    }
+    return std::atomic_load_explicit(&config_, std::memory_order_acquire);
+}
+
+bool OaidConfigManager::IsInResetTrustList(const std::string &bundleName)
+{
+    auto config = GetConfig();
+    if (config == nullptr) {
+        return false;
+    }
+    if (!config->hasResetTrustList) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "not contain resetOAIDBundleName node.");
+        return false;
+    }
+    if (config->resetOAIDBundleNames.empty()) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "oaidTrustConfig list is empty.");
+        return true;
+    }
+    if (config->resetOAIDBundleNames.count(bundleName) != 0) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "the oaidWhiteList contains this bundle name");
+        return true;
+    }
+    return false;
+}
+
+bool OaidConfigManager::ResolveConfigPath(std::string &realPath)
+{
+    char pathBuff[PATH_MAX] = {0};
+    GetOneCfgFile(OAID_TRUSTLIST_EXTENSION_CONFIG_PATH.c_str(), pathBuff, PATH_MAX);
+    char resolvedPath[PATH_MAX] = {0};
+    if (realpath(pathBuff, resolvedPath) == nullptr) {
+        GetOneCfgFile(OAID_TRUSTLIST_CONFIG_PATH.c_str(), pathBuff, PATH_MAX);
+        if (realpath(pathBuff, resolvedPath) == nullptr) {
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Parse realpath fail");
+            return false;
+        }
+    }
+    realPath = resolvedPath;
+    return true;
+}
+
+void OaidConfigManager::RefreshConfig()
+{
+    std::string realPath;
+    struct stat fileStat {};
+    if (!ResolveConfigPath(realPath) || stat(realPath.c_str(), &fileStat) != 0) {
+        configPath_.clear();
+        configSize_ = -1;
+        std::atomic_store_explicit(&config_, std::shared_ptr<const OaidServiceConfig>(), std::memory_order_release);
+        return;
+    }
+    if (realPath == configPath_ && fileStat.st_size == configSize_ &&
+        fileStat.st_mtim.tv_sec == configMtime_.tv_sec && fileStat.st_mtim.tv_nsec == configMtime_.tv_nsec) {
+        return;
+    }
+
+    std::ifstream inFile(realPath, std::ios::in);
+    if (!inFile.is_open()) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Open file error.");
+        return;
+    }
+    std::string fileContent((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+    inFile.close();
+    std::atomic_store_explicit(&config_, ParseConfig(fileContent), std::memory_order_release);
+    configPath_ = realPath;
+    configSize_ = fileStat.st_size;
+    configMtime_ = fileStat.st_mtim;
+    OAID_HILOGI(OAID_MODULE_SERVICE, "oaid service config loaded");
+}
+
+std::shared_ptr<const OaidServiceConfig> OaidConfigManager::ParseConfig(const std::string &content)
+{
+    cJSON *root = cJSON_Parse(content.c_str());
+    if (root == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "ParseJsonFromFile is not in JSON format.");
+        return nullptr;
+    }
+    auto config = std::make_shared<OaidServiceConfig>();
+    cJSON *oaidTrustConfig = cJSON_GetObjectItem(root, "resetOAIDBundleName");
+    if (oaidTrustConfig != nullptr && cJSON_IsArray(oaidTrustConfig)) {
+        config->hasResetTrustList = true;
+        int arraySize = cJSON_GetArraySize(oaidTrustConfig);
+        for (int i = 0; i < arraySize; i++) {
+            cJSON *item = cJSON_GetArrayItem(oaidTrustConfig, i);
+            if (cJSON_IsString(item) && item->valuestring != nullptr) {
+                config->resetOAIDBundleNames.emplace(item->valuestring);
+            }
+        }
+    }
+    config->providerBundleName = GetStringItem(root, "providerBundleName");
+    config->providerAbilityName = GetStringItem(root, "providerAbilityName");
+    config->providerTokenName = GetStringItem(root, "providerTokenName");
+    config->stateStoreBackend = GetStringItem(root, "stateStoreBackend");
+    cJSON_Delete(root);
+    return config;
+}
+} // namespace Cloud
+} // namespace OHOS
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_file_state_store.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "oaid_common.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+/*
+ * File layout, little endian: magic, version, entry count, then per entry key length, value length,
+ * key bytes and value bytes.
+ */
+constexpr uint32_t STATE_FILE_MAGIC = 0x5453414F;  // "OAST"
+constexpr uint32_t STATE_FILE_VERSION = 1;
+constexpr size_t STATE_FILE_HEADER_SIZE = 3 * sizeof(uint32_t);
+constexpr size_t STATE_FILE_ENTRY_HEADER_SIZE = 2 * sizeof(uint32_t);
+constexpr size_t STATE_FILE_MAX_SIZE = 1024 * 1024;
+constexpr size_t BITS_PER_BYTE = 8;
+constexpr mode_t STATE_FILE_MODE = 0600;
+const std::string STATE_FILE_TMP_SUFFIX = ".tmp";
+const std::string STATE_FILE_CORRUPT_SUFFIX = ".corrupt";
+
+void AppendUint32(std::vector<uint8_t> &buffer, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(uint32_t); i++) {
+        buffer.push_back(static_cast<uint8_t>(value >> (i * BITS_PER_BYTE)));
+    }
+}
+
+bool ReadUint32(const uint8_t *data, size_t size, size_t &offset, uint32_t &value)
+{
+    if (size - offset < sizeof(uint32_t)) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < sizeof(uint32_t); i++) {
+        value |= static_cast<uint32_t>(data[offset + i]) << (i * BITS_PER_BYTE);
+    }
+    offset += sizeof(uint32_t);
+    return true;
+}
+
+bool SyncParentDir(const std::string &path)
+{
+    size_t pos = path.find_last_of('/');
+    std::string dir = (pos == std::string::npos) ? "." : (pos == 0 ? "/" : path.substr(0, pos));
+    int fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool result = fsync(fd) == 0;
+    close(fd);
+    return result;
+}
+
+bool WriteAll(int fd, const uint8_t *data, size_t size)
+{
+    size_t written = 0;
+    while (written < size) {
+        ssize_t ret = write(fd, data + written, size - written);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    return true;
+}
+}  // namespace
+
+OaidFileStateStore::OaidFileStateStore(const std::string &path) : path_(path)
+{}
+
+OaidStateStoreStatus OaidFileStateStore::Get(const std::string &key, std::vector<uint8_t> &value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!LoadLocked()) {
+        return OaidStateStoreStatus::ERROR;
+    }
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+        return OaidStateStoreStatus::NOT_FOUND;
+    }
+    value = iter->second;
+    return OaidStateStoreStatus::SUCCESS;
+}
+
+bool OaidFileStateStore::Put(const std::string &key, const std::vector<uint8_t> &value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Rewriting the file from a map that was never loaded would drop every stored entry.
+    if (!LoadLocked()) {
+        return false;
+    }
+    EntryMap entries = entries_;
+    entries[key] = value;
+    if (!PersistLocked(entries)) {
+        return false;
+    }
+    entries_.swap(entries);
+    return true;
+}
+
+bool OaidFileStateStore::Delete(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!LoadLocked()) {
+        return false;
+    }
+    if (entries_.find(key) == entries_.end()) {
+        return true;
+    }
+    EntryMap entries = entries_;
+    entries.erase(key);
+    if (!PersistLocked(entries)) {
+        return false;
+    }
+    entries_.swap(entries);
+    return true;
+}
+
+bool OaidFileStateStore::LoadLocked()
+{
+    if (loaded_) {
+        return true;
+    }
+    int fd = open(path_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            loaded_ = true;
+            return true;
+        }
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Open state file failed, errno=%{public}d", errno);
+        return false;
+    }
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) != 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Stat state file failed, errno=%{public}d", errno);
+        close(fd);
+        return false;
+    }
+    if (fileStat.st_size <= 0 || static_cast<size_t>(fileStat.st_size) > STATE_FILE_MAX_SIZE) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "State file size is invalid");
+        close(fd);
+        return SetAsideLocked();
+    }
+    size_t size = static_cast<size_t>(fileStat.st_size);
+    void *addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Map state file failed, errno=%{public}d", errno);
+        return false;
+    }
+    EntryMap entries;
+    bool parsed = ParseEntries(static_cast<const uint8_t *>(addr), size, entries);
+    munmap(addr, size);
+    if (!parsed) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "State file is malformed");
+        return SetAsideLocked();
+    }
+    entries_.swap(entries);
+    loaded_ = true;
+    return true;
+}
+
+bool OaidFileStateStore::SetAsideLocked()
+{
+    // 损坏的文件重读也无法恢复，移到旁边保留现场后从空状态开始
+    std::string corruptPath = path_ + STATE_FILE_CORRUPT_SUFFIX;
+    if (rename(path_.c_str(), corruptPath.c_str()) != 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Set aside state file failed, errno=%{public}d", errno);
+        return false;
+    }
+    OAID_HILOGW(OAID_MODULE_SERVICE, "State file moved to %{public}s, start empty", corruptPath.c_str());
+    loaded_ = true;
+    return true;
+}
+
+bool OaidFileStateStore::ParseEntries(const uint8_t *data, size_t size, EntryMap &entries)
+{
+    size_t offset = 0;
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!ReadUint32(data, size, offset, magic) || !ReadUint32(data, size, offset, version) ||
+        !ReadUint32(data, size, offset, count) || magic != STATE_FILE_MAGIC || version != STATE_FILE_VERSION) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t keySize = 0;
+        uint32_t valueSize = 0;
+        if (!ReadUint32(data, size, offset, keySize) || !ReadUint32(data, size, offset, valueSize) ||
+            size - offset < static_cast<size_t>(keySize) + valueSize) {
+            return false;
+        }
+        std::string key(reinterpret_cast<const char *>(data + offset), keySize);
+        offset += keySize;
+        entries[key].assign(data + offset, data + offset + valueSize);
+        offset += valueSize;
+    }
+    return offset == size;
+}
+
+void OaidFileStateStore::SerializeEntries(const EntryMap &entries, std::vector<uint8_t> &buffer)
+{
+    size_t total = STATE_FILE_HEADER_SIZE;
+    for (const auto &[key, value] : entries) {
+        total += STATE_FILE_ENTRY_HEADER_SIZE + key.size() + value.size();
+    }
+    buffer.clear();
+    buffer.reserve(total);
+    AppendUint32(buffer, STATE_FILE_MAGIC);
+    AppendUint32(buffer, STATE_FILE_VERSION);
+    AppendUint32(buffer, static_cast<uint32_t>(entries.size()));
+    for (const auto &[key, value] : entries) {
+        AppendUint32(buffer, static_cast<uint32_t>(key.size()));
+        AppendUint32(buffer, static_cast<uint32_t>(value.size()));
+        buffer.insert(buffer.end(), key.begin(), key.end());
+        buffer.insert(buffer.end(), value.begin(), value.end());
+    }
+}
+
+bool OaidFileStateStore::PersistLocked(const EntryMap &entries)
+{
+    std::vector<uint8_t> buffer;
+    SerializeEntries(entries, buffer);
+    if (buffer.size() > STATE_FILE_MAX_SIZE) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "State file too large, size=%{public}zu", buffer.size());
+        return false;
+    }
+    std::string tmpPath = path_ + STATE_FILE_TMP_SUFFIX;
+    int fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, STATE_FILE_MODE);
+    if (fd < 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Create state tmp file failed, errno=%{public}d", errno);
+        return false;
+    }
+    bool result = WriteAll(fd, buffer.data(), buffer.size()) && fsync(fd) == 0;
+    close(fd);
+    // rename 是原子的，读者只会看到完整的旧文件或新文件
+    if (!result || rename(tmpPath.c_str(), path_.c_str()) != 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Persist state file failed, errno=%{public}d", errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    // The rename itself is only durable once the directory entry is on disk.
+    if (!SyncParentDir(path_)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Sync state dir failed, errno=%{public}d", errno);
+        // The new file may or may not survive a crash, reload whatever is on disk on the next access.
+        loaded_ = false;
+        return false;
+    }
+    return true;
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_importing_state_store.h"
+
+#include "oaid_common.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+const std::string IMPORT_MARKER_KEY = "oaid_state_imported";
+}  // namespace
+
+OaidImportingStateStore::OaidImportingStateStore(std::shared_ptr<IOaidStateStore> target,
+    std::shared_ptr<IOaidStateStore> source, std::vector<std::string> keys)
+    : target_(std::move(target)), source_(std::move(source)), keys_(std::move(keys))
+{}
+
+OaidStateStoreStatus OaidImportingStateStore::Get(const std::string &key, std::vector<uint8_t> &value)
+{
+    EnsureImported();
+    return target_->Get(key, value);
+}
+
+bool OaidImportingStateStore::Put(const std::string &key, const std::vector<uint8_t> &value)
+{
+    EnsureImported();
+    return target_->Put(key, value);
+}
+
+bool OaidImportingStateStore::Delete(const std::string &key)
+{
+    EnsureImported();
+    return target_->Delete(key);
+}
+
+void OaidImportingStateStore::EnsureImported()
+{
+    std::lock_guard<std::mutex> lock(importMutex_);
+    if (importDone_) {
+        return;
+    }
+    std::vector<uint8_t> marker;
+    OaidStateStoreStatus status = target_->Get(IMPORT_MARKER_KEY, marker);
+    if (status == OaidStateStoreStatus::ERROR) {
+        // The target cannot answer yet, try again on the next access.
+        return;
+    }
+    importDone_ = true;
+    if (status == OaidStateStoreStatus::SUCCESS) {
+        return;
+    }
+    bool complete = true;
+    for (const auto &key : keys_) {
+        complete = ImportKey(key) && complete;
+    }
+    if (!complete) {
+        // Not retried in this process, the source may stay broken; the next start tries again.
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Import from previous state store incomplete");
+        return;
+    }
+    if (!target_->Put(IMPORT_MARKER_KEY, std::vector<uint8_t>{1})) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Write state import marker failed");
+    }
+}
+
+bool OaidImportingStateStore::ImportKey(const std::string &key)
+{
+    std::vector<uint8_t> value;
+    OaidStateStoreStatus status = target_->Get(key, value);
+    if (status != OaidStateStoreStatus::NOT_FOUND) {
+        return status == OaidStateStoreStatus::SUCCESS;
+    }
+    status = source_->Get(key, value);
+    if (status == OaidStateStoreStatus::NOT_FOUND) {
+        return true;
+    }
+    if (status == OaidStateStoreStatus::ERROR) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Read %{public}s from previous state store failed", key.c_str());
+        return false;
+    }
+    if (!target_->Put(key, value)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Import %{public}s failed", key.c_str());
+        return false;
+    }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Imported %{public}s from previous state store", key.c_str());
+    return true;
+}
+}  // namespace Cloud
+}  // namespace OHOS
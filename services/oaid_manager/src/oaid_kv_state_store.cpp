@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_kv_state_store.h"
+
+#include <utility>
+
+#include "oaid_common.h"
+
+namespace OHOS {
+namespace Cloud {
+OaidKvStateStore::OaidKvStateStore(const std::string &storeId, KvStoreGetter getter)
+    : storeId_(storeId), getter_(std::move(getter))
+{}
+
+OaidStateStoreStatus OaidKvStateStore::Get(const std::string &key, std::vector<uint8_t> &value)
+{
+    auto kvStore = getter_();
+    if (kvStore == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Get: kvStore %{public}s is nullptr", storeId_.c_str());
+        return OaidStateStoreStatus::ERROR;
+    }
+    DistributedKv::Value kvValue;
+    DistributedKv::Status status = kvStore->Get(DistributedKv::Key(key), kvValue);
+    if (status == DistributedKv::Status::KEY_NOT_FOUND) {
+        return OaidStateStoreStatus::NOT_FOUND;
+    }
+    if (status != DistributedKv::Status::SUCCESS) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "%{public}d get value from kvStore failed", status);
+        return OaidStateStoreStatus::ERROR;
+    }
+    value = kvValue.Data();
+    return OaidStateStoreStatus::SUCCESS;
+}
+
+bool OaidKvStateStore::Put(const std::string &key, const std::vector<uint8_t> &value)
+{
+    auto kvStore = getter_();
+    if (kvStore == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Put: kvStore %{public}s is nullptr", storeId_.c_str());
+        return false;
+    }
+    DistributedKv::Status status = kvStore->Put(DistributedKv::Key(key), DistributedKv::Value(value));
+    if (status != DistributedKv::Status::SUCCESS) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "%{public}d update to kvStore failed", status);
+        return false;
+    }
+    return true;
+}
+
+bool OaidKvStateStore::Delete(const std::string &key)
+{
+    auto kvStore = getter_();
+    if (kvStore == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Delete: kvStore %{public}s is nullptr", storeId_.c_str());
+        return false;
+    }
+    DistributedKv::Status status = kvStore->Delete(DistributedKv::Key(key));
+    if (status != DistributedKv::Status::SUCCESS) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "%{public}d delete from kvStore failed", status);
+        return false;
+    }
+    return true;
+}
+}  // namespace Cloud
+}  // namespace OHOS
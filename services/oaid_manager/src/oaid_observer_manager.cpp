@@ -18,10 +18,20 @@
 #include "oaid_service.h"
 #include "oaid_common.h"
 #include "oaid_observer_manager.h"
+#include "oaid_reset_listener_proxy.h"
 
 namespace OHOS {
 namespace Cloud {
-const std::string OAID_VIRTUAL_STR = "-****-****-****-************";
+namespace {
+// 按调用方uid限额，单个应用注册再多也不会挤掉其他应用的监听
+constexpr size_t MAX_RESET_LISTENERS_PER_UID = 16;
+}  // namespace
+
+void ResetListenerDeathRecipient::OnRemoteDied(const wptr<IRemoteObject> &remote)
+{
+    DelayedSingleton<OaidObserverManager>::GetInstance()->RemoveResetListener(remote);
+}
+
 OaidObserverManager::OaidObserverManager()
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "OaidObserverManager construct");
@@ -41,23 +51,84 @@ int32_t OaidObserverManager::RegisterObserver(const sptr<IRemoteConfigObserver>
     std::unique_lock<std::shared_mutex> lockRegister(observerMutex_);
     observer_ = observer;
 
-    auto oaid = OAIDService::GetInstance()->GetOAID();
-    std::string target = oaid.substr(0, 9).append(OAID_VIRTUAL_STR);
+    uint64_t generation = 0;
+    OaidValue oaid = OAIDService::GetInstance()->GetOAID(generation);
     OAID_HILOGI(OAID_MODULE_SERVICE, "registerObserver success");
-    observer->OnOaidUpdated(oaid);
+    observer->OnOaidUpdated(oaid.ToString());
     return ERR_OK;
 }
 
-void OaidObserverManager::OnUpdateOaid(const std::string &oaid)
+void OaidObserverManager::OnUpdateOaid(const OaidValue &oaid)
 {
     std::shared_lock<std::shared_mutex> lockUpdate(observerMutex_);
     if (observer_ == nullptr) {
         OAID_HILOGI(OAID_MODULE_SERVICE, "observer is null, error code is: %{public}d", ERR_NULL_POINTER);
         return;
     }
-    std::string target = oaid.substr(0, 9).append(OAID_VIRTUAL_STR);
-    OAID_HILOGI(OAID_MODULE_SERVICE, "OnOaidUpdated success oaid is: %{public}s", target.c_str());
-    observer_->OnOaidUpdated(oaid);
+    OaidValue::FormatBuffer masked;
+    oaid.FormatMasked(masked);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "OnOaidUpdated success oaid is: %{public}s", masked.data());
+    observer_->OnOaidUpdated(oaid.ToString());
+}
+
+int32_t OaidObserverManager::RegisterResetListener(const sptr<IOaidResetListener> &listener, int32_t callingUid)
+{
+    if (listener == nullptr || listener->AsObject() == nullptr) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "reset listener is null");
+        return ERR_INVALID_PARAM;
+    }
+    std::lock_guard<std::mutex> lock(resetListenerMutex_);
+    size_t uidCount = 0;
+    for (const auto &item : resetListeners_) {
+        if (item.listener->AsObject() == listener->AsObject()) {
+            return ERR_OK;
+        }
+        if (item.uid == callingUid) {
+            uidCount++;
+        }
+    }
+    if (uidCount >= MAX_RESET_LISTENERS_PER_UID) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "too many reset listeners of uid %{public}d", callingUid);
+        return ERR_SYSYTEM_ERROR;
+    }
+    if (resetListenerDeathRecipient_ == nullptr) {
+        resetListenerDeathRecipient_ = new (std::nothrow) ResetListenerDeathRecipient();
+    }
+    if (resetListenerDeathRecipient_ == nullptr ||
+        !listener->AsObject()->AddDeathRecipient(resetListenerDeathRecipient_)) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "add reset listener death recipient failed");
+        return ERR_SYSYTEM_ERROR;
+    }
+    resetListeners_.push_back({ listener, callingUid });
+    OAID_HILOGI(OAID_MODULE_SERVICE, "register reset listener success, count=%{public}zu", resetListeners_.size());
+    return ERR_OK;
+}
+
+void OaidObserverManager::RemoveResetListener(const wptr<IRemoteObject> &remote)
+{
+    std::lock_guard<std::mutex> lock(resetListenerMutex_);
+    for (auto iter = resetListeners_.begin(); iter != resetListeners_.end(); ++iter) {
+        if (iter->listener->AsObject().GetRefPtr() == remote.GetRefPtr()) {
+            resetListeners_.erase(iter);
+            return;
+        }
+    }
+}
+
+void OaidObserverManager::NotifyResetListeners(uint64_t generation)
+{
+    std::vector<sptr<IOaidResetListener>> listeners;
+    {
+        std::lock_guard<std::mutex> lock(resetListenerMutex_);
+        listeners.reserve(resetListeners_.size());
+        for (const auto &item : resetListeners_) {
+            listeners.push_back(item.listener);
+        }
+    }
+    // One-way calls, a slow client never blocks the reset.
+    for (const auto &listener : listeners) {
+        listener->OnOaidReset(generation);
+    }
 }
 }  // namespace Cloud
 }  // namespace OHOS
\ No newline at end of file
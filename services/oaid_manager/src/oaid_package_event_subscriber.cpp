@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_package_event_subscriber.h"
+
+#include "bundle_mgr_helper.h"
+#include "common_event_manager.h"
+#include "common_event_support.h"
+#include "oaid_common.h"
+#include "oaid_rdb_manager.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+const std::string EVENT_PARAM_UID = "uid";
+const std::string EVENT_PARAM_USER_ID = "userId";
+constexpr int32_t BASE_USER_RANGE = 200000;  // uid = userId * BASE_USER_RANGE + appId
+}  // namespace
+
+std::mutex OaidPackageEventSubscriber::subscriberMutex_;
+std::shared_ptr<OaidPackageEventSubscriber> OaidPackageEventSubscriber::subscriber_ = nullptr;
+
+OaidPackageEventSubscriber::OaidPackageEventSubscriber(const EventFwk::CommonEventSubscribeInfo &subscribeInfo)
+    : EventFwk::CommonEventSubscriber(subscribeInfo)
+{}
+
+void OaidPackageEventSubscriber::OnReceiveEvent(const EventFwk::CommonEventData &data)
+{
+    const AAFwk::Want &want = data.GetWant();
+    const std::string &action = want.GetAction();
+    if (action == EventFwk::CommonEventSupport::COMMON_EVENT_USER_REMOVED) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "user removed, userId=%{public}d", data.GetCode());
+        OaidRdbManager::GetInstance().SchedulePurgeUser(data.GetCode());
+        return;
+    }
+    int uid = want.GetIntParam(EVENT_PARAM_UID, -1);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "package event %{public}s, uid=%{public}d", action.c_str(), uid);
+    if (action == EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED) {
+        std::string bundleName = want.GetElement().GetBundleName();
+        int32_t userId = want.GetIntParam(EVENT_PARAM_USER_ID, uid < 0 ? -1 : uid / BASE_USER_RANGE);
+        if (!bundleName.empty() && userId >= 0) {
+            OaidRdbManager::GetInstance().SchedulePurgeBundle(userId, bundleName);
+        }
+    }
+    auto bundleMgrHelper = DelayedSingleton<BundleMgrHelper>::GetInstance();
+    if (bundleMgrHelper == nullptr) {
+        return;
+    }
+    // Without a uid the changed package is unknown, drop the whole cache.
+    bundleMgrHelper->InvalidateBundleNameCache(uid);
+}
+
+bool OaidPackageEventSubscriber::Subscribe()
+{
+    std::lock_guard<std::mutex> lock(subscriberMutex_);
+    if (subscriber_ != nullptr) {
+        return true;
+    }
+    EventFwk::MatchingSkills matchingSkills;
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_ADDED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_PACKAGE_REPLACED);
+    matchingSkills.AddEvent(EventFwk::CommonEventSupport::COMMON_EVENT_USER_REMOVED);
+    EventFwk::CommonEventSubscribeInfo subscribeInfo(matchingSkills);
+    auto subscriber = std::make_shared<OaidPackageEventSubscriber>(subscribeInfo);
+    if (!EventFwk::CommonEventManager::SubscribeCommonEvent(subscriber)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "subscribe package event failed");
+        return false;
+    }
+    subscriber_ = subscriber;
+    OAID_HILOGI(OAID_MODULE_SERVICE, "subscribe package event success");
+    return true;
+}
+
+void OaidPackageEventSubscriber::Unsubscribe()
+{
+    std::lock_guard<std::mutex> lock(subscriberMutex_);
+    if (subscriber_ == nullptr) {
+        return;
+    }
+    if (!EventFwk::CommonEventManager::UnSubscribeCommonEvent(subscriber_)) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "unsubscribe package event failed");
+    }
+    subscriber_ = nullptr;
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_permission_usage_reporter.h"
+
+#include <cinttypes>
+
+#include "event_runner.h"
+#include "oaid_common.h"
+#include "privacy_kit.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+constexpr int64_t FLUSH_WINDOW_MS = 1000;
+constexpr size_t MAX_PENDING_RECORDS = 256;
+const std::string FLUSH_TASK_NAME = "oaid_permission_usage_flush";
+}  // namespace
+
+OaidPermissionUsageReporter& OaidPermissionUsageReporter::GetInstance()
+{
+    static OaidPermissionUsageReporter instance;
+    return instance;
+}
+
+void OaidPermissionUsageReporter::Report(
+    Security::AccessToken::AccessTokenID tokenId, const std::string &permissionName, bool granted)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = pending_.find(UsageKey(tokenId, permissionName));
+    if (iter == pending_.end()) {
+        if (pending_.size() >= MAX_PENDING_RECORDS) {
+            droppedCount_++;
+            return;
+        }
+        iter = pending_.emplace(UsageKey(tokenId, permissionName), UsageCount()).first;
+    }
+    if (granted) {
+        iter->second.successCount++;
+    } else {
+        iter->second.failCount++;
+    }
+    if (!flushScheduled_ && !ScheduleFlushLocked()) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "schedule permission usage flush failed");
+    }
+}
+
+bool OaidPermissionUsageReporter::ScheduleFlushLocked()
+{
+    if (handler_ == nullptr) {
+        auto runner = AppExecFwk::EventRunner::Create("oaid_privacy");
+        if (runner == nullptr) {
+            return false;
+        }
+        handler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    flushScheduled_ = handler_->PostTask([this]() { Flush(); }, FLUSH_TASK_NAME, FLUSH_WINDOW_MS);
+    return flushScheduled_;
+}
+
+void OaidPermissionUsageReporter::Flush()
+{
+    std::map<UsageKey, UsageCount> records;
+    uint64_t droppedCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        records.swap(pending_);
+        droppedCount = droppedCount_;
+        droppedCount_ = 0;
+        if (flushScheduled_ && handler_ != nullptr) {
+            handler_->RemoveTask(FLUSH_TASK_NAME);
+        }
+        flushScheduled_ = false;
+    }
+    if (droppedCount > 0) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "permission usage records dropped: %{public}" PRIu64, droppedCount);
+    }
+    for (const auto &record : records) {
+        int32_t ret = Security::AccessToken::PrivacyKit::AddPermissionUsedRecord(
+            record.first.first, record.first.second, record.second.successCount, record.second.failCount);
+        if (ret != 0) {
+            OAID_HILOGI(OAID_MODULE_SERVICE, "AddPermissionUsedRecord ret=%{public}d", ret);
+        }
+    }
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_rdb_maintenance.h"
+
+#include <chrono>
+#include <cinttypes>
+
+#include "event_runner.h"
+#include "oaid_common.h"
+#include "oaid_rdb_manager.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+const std::string MAINTENANCE_TASK = "oaid_rdb_maintenance";
+constexpr int64_t ONE_MINUTE_MS = 60 * 1000LL;
+constexpr int64_t RETENTION_MS = 10 * 24 * 60 * ONE_MINUTE_MS;
+constexpr int64_t START_DELAY_MS = 10 * 1000;  // Keep the first pass out of the service start up.
+constexpr int64_t CONTINUE_DELAY_MS = 1000;   // Next slice when a pass ran out of budget.
+constexpr int64_t INTERVAL_MS = 24 * 60 * ONE_MINUTE_MS;
+constexpr int64_t PASS_TIME_BUDGET_MS = 200;
+constexpr size_t DELETE_CHUNK_ROWS = 500;
+constexpr uint64_t ANALYZE_MIN_REMOVED_ROWS = 10000;
+constexpr int64_t VACUUM_MIN_PAGES = 256;
+constexpr int64_t VACUUM_FREELIST_PERCENT = 25;
+constexpr int64_t PERCENT = 100;
+
+int64_t GetCurrentTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}  // namespace
+
+OaidRdbMaintenance& OaidRdbMaintenance::GetInstance()
+{
+    static OaidRdbMaintenance instance;
+    return instance;
+}
+
+void OaidRdbMaintenance::Start()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = false;
+    }
+    Schedule(START_DELAY_MS);
+}
+
+void OaidRdbMaintenance::Stop()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (handler_ != nullptr) {
+        handler_->RemoveTask(MAINTENANCE_TASK);
+    }
+    scheduled_ = false;
+    stopped_ = true;  // A pass still running must not schedule the next one.
+    reconciled_.store(false);
+}
+
+OaidRdbMaintenanceStats OaidRdbMaintenance::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void OaidRdbMaintenance::Schedule(int64_t delayMs)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (scheduled_ || stopped_) {
+        return;
+    }
+    if (handler_ == nullptr) {
+        auto runner = AppExecFwk::EventRunner::Create("oaid_rdb_maintenance");
+        if (runner == nullptr) {
+            OAID_HILOGW(OAID_MODULE_SERVICE, "Create rdb maintenance runner failed");
+            return;
+        }
+        handler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    scheduled_ = handler_->PostTask([this]() { RunPass(); }, MAINTENANCE_TASK, delayMs,
+        AppExecFwk::EventQueue::Priority::LOW);
+    if (!scheduled_) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Post rdb maintenance task failed");
+    }
+}
+
+void OaidRdbMaintenance::RunPass()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        scheduled_ = false;
+    }
+    OaidRdbManager& rdbManager = OaidRdbManager::GetInstance();
+    if (rdbManager.Init() != ERR_OK) {
+        Schedule(INTERVAL_MS);
+        return;
+    }
+    // Removals missed while the service was not running, one BMS call per user.
+    if (!reconciled_.exchange(true)) {
+        for (int32_t userId : rdbManager.QueryAllUserIds()) {
+            rdbManager.ReconcileUninstalledAppRecords(userId);
+        }
+    }
+
+    int64_t begin = GetSteadyTimeMs();
+    uint64_t removed = 0;
+    bool finished = DeleteExpired(begin + PASS_TIME_BUDGET_MS, removed);
+    removedSinceAnalyze_ += removed;
+    if (finished) {
+        CompactIfNeeded();
+    }
+    int64_t duration = GetSteadyTimeMs() - begin;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.lastRunTimeMs = GetCurrentTimeMs();
+        stats_.lastRunDurationMs = duration;
+        stats_.lastRemovedRows = removed;
+        stats_.totalRemovedRows += removed;
+    }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "RDB maintenance pass removed=%{public}" PRIu64 ", cost=%{public}" PRId64
+        "ms, finished=%{public}d", removed, duration, finished);
+    Schedule(finished ? INTERVAL_MS : CONTINUE_DELAY_MS);
+}
+
+bool OaidRdbMaintenance::DeleteExpired(int64_t deadline, uint64_t& removed)
+{
+    OaidRdbManager& rdbManager = OaidRdbManager::GetInstance();
+    int64_t cutoffMs = (GetCurrentTimeMs() - RETENTION_MS) / ONE_MINUTE_MS * ONE_MINUTE_MS;
+    for (int32_t userId : rdbManager.QueryAllUserIds()) {
+        bool hasMore = true;
+        while (hasMore) {
+            if (GetSteadyTimeMs() >= deadline) {
+                return false;
+            }
+            size_t deleted = 0;
+            if (rdbManager.DeleteExpiredAccessRecords(userId, cutoffMs, DELETE_CHUNK_ROWS, deleted, hasMore) !=
+                ERR_OK) {
+                break;
+            }
+            removed += deleted;
+        }
+    }
+    return true;
+}
+
+void OaidRdbMaintenance::CompactIfNeeded()
+{
+    OaidRdbManager& rdbManager = OaidRdbManager::GetInstance();
+    int64_t pageCount = 0;
+    int64_t freelistCount = 0;
+    bool vacuumed = false;
+    if (rdbManager.GetPageCounts(pageCount, freelistCount) == ERR_OK && pageCount >= VACUUM_MIN_PAGES &&
+        freelistCount * PERCENT >= pageCount * VACUUM_FREELIST_PERCENT) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "RDB fragmented, pages=%{public}" PRId64 ", free=%{public}" PRId64,
+            pageCount, freelistCount);
+        vacuumed = rdbManager.Vacuum() == ERR_OK;
+        if (vacuumed) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.lastVacuumTimeMs = GetCurrentTimeMs();
+        }
+    }
+    // Statistics go stale once the row counts shift a lot, VACUUM rebuilds every index too.
+    if ((vacuumed || removedSinceAnalyze_ >= ANALYZE_MIN_REMOVED_ROWS) && rdbManager.Analyze() == ERR_OK) {
+        removedSinceAnalyze_ = 0;
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.lastAnalyzeTimeMs = GetCurrentTimeMs();
+    }
+}
+}  // namespace Cloud
+}  // namespace OHOS
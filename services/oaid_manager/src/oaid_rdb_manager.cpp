@@ -14,22 +14,47 @@
  */
 
 #include "oaid_rdb_manager.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "oaid_access_record_cursor.h"
 #include "oaid_common.h"
+#include "oaid_rdb_maintenance.h"
 
 namespace OHOS {
 namespace Cloud {
 
 namespace {
 constexpr int DB_VERSION_INIT = 1; // 此版本起，新增anco_s_status和anco_a_record表
-const int DATABASE_VERSION = DB_VERSION_INIT;
+constexpr int DB_VERSION_ACCESS_RECORD_INDEX = 2; // 此版本起，anco_a_record新增(user_id, time)和(user_id, bn, uid, time)索引
+constexpr int DB_VERSION_ACCESS_MINUTE_ROLLUP = 3; // 此版本起，新增anco_a_minute按分钟聚合表
+constexpr int DB_VERSION_ACCESS_MINUTE_TIME_INDEX = 4; // 此版本起，anco_a_minute新增(user_id, first_time, bn, uid)索引
+const int DATABASE_VERSION = DB_VERSION_ACCESS_MINUTE_TIME_INDEX;
 constexpr size_t MAX_DELETE_COUNT = 100;
 const std::string DB_PATH = "/data/service/el2/public/oaid_service_manager/database/oaid.db";
+constexpr int READ_CONNECTION_SIZE = 4;  // WAL readers, queries run beside each other and beside the writer.
 const std::string SWITCH_STATUS_TABLE = "anco_s_status";
 const std::string ACCESS_RECORD_TABLE = "anco_a_record";
+const std::string ACCESS_MINUTE_TABLE = "anco_a_minute";
 const int64_t ONE_MINUTE_MS = 60 * 1000LL;
 const int64_t TIME_DIFF_THRESHOLD_MS = 200;
 const int64_t SEVEN_DAYS_MS = 7 * 24 * 60 * ONE_MINUTE_MS;
-const int64_t TEN_DAYS_MS = 10 * 24 * 60 * ONE_MINUTE_MS;
+const std::string ACCESS_RECORD_JOURNAL_PATH =
+    "/data/service/el2/public/oaid_service_manager/database/anco_a_record.journal";
+constexpr size_t ACCESS_RECORD_JOURNAL_CAPACITY = 1024;
+constexpr size_t ACCESS_RECORD_FLUSH_THRESHOLD = 64;  // Pending records that trigger an immediate flush.
+constexpr size_t ACCESS_RECORD_FLUSH_BATCH_SIZE = 256;  // Records committed per transaction.
+constexpr int64_t ACCESS_RECORD_FLUSH_DELAY_MS = 1000;
+const std::string ACCESS_RECORD_FLUSH_TASK = "oaid_access_record_flush";
+const std::string PURGE_BUNDLE_TASK = "oaid_purge_bundle";
+const std::string PURGE_USER_TASK = "oaid_purge_user";
+
+int64_t GetCurrentTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
 
 // 表定义：表名 -> (字段定义, 主键)
 const std::vector<std::tuple<std::string, std::string, std::string>>& GetTableDefinitions()
@@ -47,54 +72,130 @@ const std::vector<std::tuple<std::string, std::string, std::string>>& GetTableDe
     };
     return tables;
 }
-}
 
-struct MinuteGroupKey {
-    int32_t userId;
-    std::string bundleName;
-    std::string uid;
-    int64_t minuteGroup;
-    bool operator<(const MinuteGroupKey& other) const
-    {
-        if (userId != other.userId) return userId < other.userId;
-        if (bundleName != other.bundleName) return bundleName < other.bundleName;
-        if (uid != other.uid) return uid < other.uid;
-        return minuteGroup < other.minuteGroup;
-    }
-};
+// One statement per write, an existing row keeps its create_time.
+const std::string SWITCH_STATUS_UPSERT_SQL = "INSERT INTO " + SWITCH_STATUS_TABLE +
+    " (user_id, bn, uid, res, create_time, update_time) VALUES (?, ?, ?, ?, ?, ?)"
+    " ON CONFLICT(user_id, bn, uid) DO UPDATE SET res = excluded.res, update_time = excluded.update_time";
 
-bool MergeTimeList(const std::vector<std::pair<int64_t, int32_t>>& timeList,
-    std::vector<std::pair<int64_t, int32_t>>& mergedList)
+const std::string SWITCH_STATUS_LOAD_SQL = "SELECT bn, uid, res FROM " + SWITCH_STATUS_TABLE + " WHERE user_id = ?";
+
+// Merge one access into its minute row: a new burst starts when it is more than TIME_DIFF_THRESHOLD_MS after the
+// start of the current one. Exact when the accesses of an app arrive in time order.
+const std::string ACCESS_MINUTE_UPSERT_SQL = "INSERT INTO " + ACCESS_MINUTE_TABLE +
+    " (user_id, bn, uid, minute, first_time, burst_start, cnt) VALUES (?, ?, ?, ?, ?, ?, 1)"
+    " ON CONFLICT(user_id, bn, uid, minute) DO UPDATE SET"
+    " cnt = cnt + (CASE WHEN excluded.burst_start - burst_start > " + std::to_string(TIME_DIFF_THRESHOLD_MS) +
+    " THEN 1 ELSE 0 END),"
+    " burst_start = (CASE WHEN excluded.burst_start - burst_start > " + std::to_string(TIME_DIFF_THRESHOLD_MS) +
+    " THEN excluded.burst_start ELSE burst_start END),"
+    " first_time = MIN(first_time, excluded.first_time)";
+
+std::vector<NativeRdb::ValueObject> BuildAccessMinuteArgs(int32_t userId, const std::string& bundleName,
+    const std::string& uid, int64_t time)
 {
-    if (timeList.empty()) {
-        return false;
+    return {
+        NativeRdb::ValueObject(userId),
+        NativeRdb::ValueObject(bundleName),
+        NativeRdb::ValueObject(uid),
+        NativeRdb::ValueObject(time / ONE_MINUTE_MS),
+        NativeRdb::ValueObject(time),
+        NativeRdb::ValueObject(time)
+    };
+}
+
+// Rebuild anco_a_minute from the raw records, in time order per app so the burst merge is exact. Only the
+// minutes that queries still return are rebuilt, older raw rows are left to the retention sweep.
+int BackfillAccessMinuteTable(NativeRdb::RdbStore& store)
+{
+    int err = store.ExecuteSql("DELETE FROM " + ACCESS_MINUTE_TABLE);
+    if (err != NativeRdb::E_OK) {
+        return err;
     }
-    mergedList.push_back(timeList[0]);
-    for (size_t i = 1; i < timeList.size(); ++i) {
-        int64_t timeDiff = timeList[i].first - mergedList.back().first;
-        if (timeDiff <= TIME_DIFF_THRESHOLD_MS) {
-            mergedList.back().second += timeList[i].second;
-        } else {
-            mergedList.push_back(timeList[i]);
+    int64_t windowStart = (GetCurrentTimeMs() - SEVEN_DAYS_MS) / ONE_MINUTE_MS * ONE_MINUTE_MS;
+    auto resultSet = store.QuerySql("SELECT user_id, bn, uid, time FROM " + ACCESS_RECORD_TABLE +
+        " WHERE time >= ? ORDER BY user_id, bn, uid, time", { NativeRdb::ValueObject(windowStart) });
+    if (resultSet == nullptr) {
+        return NativeRdb::E_ERROR;
+    }
+    size_t rows = 0;
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        int32_t userId = 0;
+        std::string bundleName;
+        std::string uid;
+        int64_t time = 0;
+        resultSet->GetInt(0, userId);
+        resultSet->GetString(1, bundleName);
+        resultSet->GetString(2, uid);
+        resultSet->GetLong(3, time);  // 3: time column
+        err = store.ExecuteSql(ACCESS_MINUTE_UPSERT_SQL, BuildAccessMinuteArgs(userId, bundleName, uid, time));
+        if (err != NativeRdb::E_OK) {
+            resultSet->Close();
+            return err;
         }
+        rows++;
     }
-    return !mergedList.empty();
+    resultSet->Close();
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Backfill %{public}s from %{public}zu records", ACCESS_MINUTE_TABLE.c_str(),
+        rows);
+    return NativeRdb::E_OK;
 }
 
-void BuildAccessRecordInfo(const MinuteGroupKey& key,
-    const std::vector<std::pair<int64_t, int32_t>>& mergedList,
-    std::vector<AncoAccessRecordInfo>& result)
+struct RdbMigration {
+    int version;
+    std::vector<std::string> statements;
+    int (*apply)(NativeRdb::RdbStore& store);  // Runs after the statements, nullptr if not needed.
+};
+
+// 版本升级步骤：每个版本只写增量语句，且必须可重复执行
+const std::vector<RdbMigration>& GetMigrations()
 {
-    if (mergedList.empty()) {
-        return;
+    static const std::vector<RdbMigration> migrations = {
+        { DB_VERSION_ACCESS_RECORD_INDEX,
+          { "CREATE INDEX IF NOT EXISTS idx_anco_a_record_user_time ON " + ACCESS_RECORD_TABLE + " (user_id, time)",
+            "CREATE INDEX IF NOT EXISTS idx_anco_a_record_user_app_time ON " + ACCESS_RECORD_TABLE +
+            " (user_id, bn, uid, time)" },
+          nullptr },
+        { DB_VERSION_ACCESS_MINUTE_ROLLUP,
+          { "CREATE TABLE IF NOT EXISTS " + ACCESS_MINUTE_TABLE + " (user_id INTEGER NOT NULL, bn TEXT NOT NULL, "
+            "uid TEXT NOT NULL, minute INTEGER NOT NULL, first_time INTEGER NOT NULL, burst_start INTEGER NOT NULL, "
+            "cnt INTEGER NOT NULL DEFAULT 1, PRIMARY KEY (user_id, bn, uid, minute))" },
+          BackfillAccessMinuteTable },
+        { DB_VERSION_ACCESS_MINUTE_TIME_INDEX,
+          { "CREATE INDEX IF NOT EXISTS idx_anco_a_minute_user_time ON " + ACCESS_MINUTE_TABLE +
+            " (user_id, first_time, bn, uid)" },
+          nullptr },
+    };
+    return migrations;
+}
+
+// Apply the migrations in (fromVersion, toVersion], in order.
+int ApplyMigrations(NativeRdb::RdbStore& store, int fromVersion, int toVersion)
+{
+    for (const auto& migration : GetMigrations()) {
+        if (migration.version <= fromVersion || migration.version > toVersion) {
+            continue;
+        }
+        for (const auto& sql : migration.statements) {
+            int err = store.ExecuteSql(sql);
+            if (err != NativeRdb::E_OK) {
+                OAID_HILOGE(OAID_MODULE_SERVICE, "Migrate to version %{public}d failed, err=%{public}d",
+                    migration.version, err);
+                return err;
+            }
+        }
+        if (migration.apply != nullptr) {
+            int err = migration.apply(store);
+            if (err != NativeRdb::E_OK) {
+                OAID_HILOGE(OAID_MODULE_SERVICE, "Migrate to version %{public}d failed, err=%{public}d",
+                    migration.version, err);
+                return err;
+            }
+        }
+        OAID_HILOGI(OAID_MODULE_SERVICE, "Migrate to version %{public}d success", migration.version);
     }
-    AncoAccessRecordInfo info;
-    info.userId = key.userId;
-    info.bundleName = key.bundleName;
-    info.uid = key.uid;
-    info.time = std::to_string(mergedList.front().first);
-    info.count = static_cast<int32_t>(mergedList.size());
-    result.push_back(std::move(info));
+    return NativeRdb::E_OK;
+}
 }
 
 int32_t OaidRdbManager::CreateTable(NativeRdb::RdbStore& store, const std::string& tableName,
@@ -124,11 +225,13 @@ public:
             }
         }
         OAID_HILOGI(OAID_MODULE_SERVICE, "RDB tables created successfully");
-        return NativeRdb::E_OK;
+        // The table definitions are the DB_VERSION_INIT schema, later versions are reached through the migrations.
+        return ApplyMigrations(store, DB_VERSION_INIT, DATABASE_VERSION);
     }
     int OnUpgrade(NativeRdb::RdbStore& store, int currentVersion, int targetVersion) override
     {
-        return NativeRdb::E_OK;
+        OAID_HILOGI(OAID_MODULE_SERVICE, "RDB upgrade from %{public}d to %{public}d", currentVersion, targetVersion);
+        return ApplyMigrations(store, currentVersion, targetVersion);
     }
 };
 
@@ -147,12 +250,42 @@ OaidRdbManager& OaidRdbManager::GetInstance()
 
 int32_t OaidRdbManager::Init()
 {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    if (rdbStore_ != nullptr) {
+    if (ready_.load(std::memory_order_acquire)) {
         return ERR_OK;
     }
+    {
+        // Same order as FlushAccessRecords, so no flush can commit the records being replayed a second time.
+        std::lock_guard<std::mutex> flushLock(flushMutex_);
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (rdbStore_ != nullptr) {
+            // Store, replay and ready_ are set in one critical section, an open store is a ready one.
+            return ERR_OK;
+        }
+        int32_t ret = OpenStoreLocked();
+        if (ret != ERR_OK) {
+            return ret;
+        }
+        // Records journaled before a crash or an unload are committed before anyone reads the table.
+        if (journal_.Open(ACCESS_RECORD_JOURNAL_PATH, ACCESS_RECORD_JOURNAL_CAPACITY) > 0) {
+            FlushAccessRecordsLocked();
+        }
+        ready_.store(true, std::memory_order_release);
+    }
+    OaidRdbMaintenance::GetInstance().Start();
+    return ERR_OK;
+}
+
+bool OaidRdbManager::IsReady() const
+{
+    return ready_.load(std::memory_order_acquire);
+}
+
+int32_t OaidRdbManager::OpenStoreLocked()
+{
     NativeRdb::RdbStoreConfig config(DB_PATH);
     config.SetSecurityLevel(NativeRdb::SecurityLevel::S2);
+    config.SetJournalMode(NativeRdb::JournalMode::MODE_WAL);
+    config.SetReadConSize(READ_CONNECTION_SIZE);
     int errCode = NativeRdb::E_OK;
     OaidRdbOpenCallback callback;
     rdbStore_ = NativeRdb::RdbHelper::GetRdbStore(config, DATABASE_VERSION, callback, errCode);
@@ -172,6 +305,18 @@ int32_t OaidRdbManager::Init()
     return ERR_OK;
 }
 
+int OaidRdbManager::UpsertSwitchStatusLocked(const AncoSwitchStatusInfo& info, int64_t currentTime)
+{
+    return rdbStore_->ExecuteSql(SWITCH_STATUS_UPSERT_SQL, {
+        NativeRdb::ValueObject(info.userId),
+        NativeRdb::ValueObject(info.bundleName),
+        NativeRdb::ValueObject(info.uid),
+        NativeRdb::ValueObject(info.status),
+        NativeRdb::ValueObject(currentTime),
+        NativeRdb::ValueObject(currentTime)
+    });
+}
+
 int32_t OaidRdbManager::InsertOrReplaceSwitchStatus(int32_t userId,
     const std::string& bundleName, const std::string& uid, int32_t status)
 {
@@ -180,57 +325,104 @@ int32_t OaidRdbManager::InsertOrReplaceSwitchStatus(int32_t userId,
         OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
         return ERR_DB_CONNECT_FAILED;
     }
-    int64_t currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-    NativeRdb::RdbPredicates predicates(SWITCH_STATUS_TABLE);
-    predicates.EqualTo("user_id", NativeRdb::ValueObject(userId));
-    predicates.And();
-    predicates.EqualTo("bn", NativeRdb::ValueObject(bundleName));
-    predicates.And();
-    predicates.EqualTo("uid", NativeRdb::ValueObject(uid));
-    int64_t count = 0;
-    int err = rdbStore_->Count(count, predicates);
+    int err = UpsertSwitchStatusLocked({ userId, bundleName, uid, status }, GetCurrentTimeMs());
     if (err != NativeRdb::E_OK) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to count switch status, err=%{public}d", err);
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to upsert switch status, err=%{public}d", err);
         return ERR_DB_CONNECT_FAILED;
     }
-    if (count > 0) {
-        NativeRdb::ValuesBucket row;
-        row.PutInt("res", status);
-        row.PutLong("update_time", currentTime);
-        int changedRows = 0;
-        err = rdbStore_->Update(changedRows, row, predicates);
-        if (err != NativeRdb::E_OK) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to update switch status, err=%{public}d", err);
-            return ERR_DB_CONNECT_FAILED;
-        }
-    } else {
-        NativeRdb::ValuesBucket row;
-        row.PutInt("user_id", userId);
-        row.PutString("bn", bundleName);
-        row.PutString("uid", uid);
-        row.PutInt("res", status);
-        row.PutLong("create_time", currentTime);
-        row.PutLong("update_time", currentTime);
-        int64_t outRowId = 0;
-        err = rdbStore_->Insert(outRowId, SWITCH_STATUS_TABLE, row);
+    switchStatusCache_.Put({ userId, bundleName, uid, status });
+    return ERR_OK;
+}
+
+int32_t OaidRdbManager::InsertOrReplaceSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos)
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (rdbStore_ == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
+        return ERR_DB_CONNECT_FAILED;
+    }
+    int err = rdbStore_->BeginTransaction();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to begin transaction, err=%{public}d", err);
+        return ERR_DB_CONNECT_FAILED;
+    }
+    int64_t currentTime = GetCurrentTimeMs();
+    for (const auto& info : infos) {
+        err = UpsertSwitchStatusLocked(info, currentTime);
         if (err != NativeRdb::E_OK) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to insert switch status, err=%{public}d", err);
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to upsert switch status, err=%{public}d", err);
+            rdbStore_->RollBack();
             return ERR_DB_CONNECT_FAILED;
         }
     }
+    err = rdbStore_->Commit();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to commit switch status, err=%{public}d", err);
+        rdbStore_->RollBack();
+        return ERR_DB_CONNECT_FAILED;
+    }
+    for (const auto& info : infos) {
+        switchStatusCache_.Put(info);
+    }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Upsert switch status success, count=%{public}zu", infos.size());
     return ERR_OK;
 }
 
+bool OaidRdbManager::QueryCachedSwitchStatus(int32_t userId, const std::string& bundleName, const std::string& uid,
+    std::vector<AncoSwitchStatusInfo>& result)
+{
+    int32_t status = 0;
+    auto lookup = switchStatusCache_.Lookup(userId, bundleName, uid, status);
+    if (lookup == OaidSwitchStatusCache::LookupResult::NOT_LOADED) {
+        return false;
+    }
+    if (lookup == OaidSwitchStatusCache::LookupResult::FOUND) {
+        result.push_back({ userId, bundleName, uid, status });
+    }
+    return true;
+}
+
+bool OaidRdbManager::LoadSwitchStatusLocked(int32_t userId)
+{
+    auto resultSet = rdbStore_->QuerySql(SWITCH_STATUS_LOAD_SQL, { NativeRdb::ValueObject(userId) });
+    if (resultSet == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Load switch status result set is null");
+        return false;
+    }
+    std::vector<AncoSwitchStatusInfo> rows;
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        AncoSwitchStatusInfo info;
+        info.userId = userId;
+        resultSet->GetString(0, info.bundleName);
+        resultSet->GetString(1, info.uid);
+        resultSet->GetInt(2, info.status);
+        rows.push_back(std::move(info));
+    }
+    resultSet->Close();
+    switchStatusCache_.LoadUser(userId, rows);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Load switch status success, userId=%{public}d, count=%{public}zu", userId,
+        rows.size());
+    return true;
+}
+
 std::vector<AncoSwitchStatusInfo> OaidRdbManager::QuerySwitchStatus(int32_t userId,
     const std::string& bundleName, const std::string& uid)
 {
-    std::shared_lock<std::shared_mutex> lock(mutex_);
+    bool pointLookup = !bundleName.empty() && !uid.empty();
     std::vector<AncoSwitchStatusInfo> result;
+    if (pointLookup && QueryCachedSwitchStatus(userId, bundleName, uid, result)) {
+        return result;
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (rdbStore_ == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
         return result;
     }
+    // Writers are excluded while the table of the user is loaded, so no committed write can be missed.
+    if (pointLookup && (switchStatusCache_.IsLoaded(userId) || LoadSwitchStatusLocked(userId)) &&
+        QueryCachedSwitchStatus(userId, bundleName, uid, result)) {
+        return result;
+    }
     NativeRdb::RdbPredicates predicates(SWITCH_STATUS_TABLE);
     predicates.EqualTo("user_id", NativeRdb::ValueObject(userId));
     if (!bundleName.empty() && !uid.empty()) {
@@ -260,25 +452,29 @@ std::vector<AncoSwitchStatusInfo> OaidRdbManager::QuerySwitchStatus(int32_t user
     return result;
 }
 
-std::vector<AncoAccessRecordInfo> OaidRdbManager::QueryAccessRecordsFromDatabase(
-    int32_t userId, const std::string& bundleName, const std::string& uid, int64_t sevenDaysAgo)
+std::vector<AncoAccessRecordInfo> OaidRdbManager::QueryAccessRecords(int32_t userId,
+    const std::string& bundleName, const std::string& uid)
 {
+    // Journaled records must be visible to the query.
+    FlushAccessRecords();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     std::vector<AncoAccessRecordInfo> result;
-    std::string sql;
+    if (rdbStore_ == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
+        return result;
+    }
+    int64_t sevenDaysAgoMinute = (GetCurrentTimeMs() - SEVEN_DAYS_MS) / ONE_MINUTE_MS;
+    // anco_a_minute already holds one row per minute with its merged burst count, read it in key order.
+    std::string sql = "SELECT user_id, bn, uid, first_time, cnt FROM " + ACCESS_MINUTE_TABLE + " WHERE user_id = ?";
     std::vector<NativeRdb::ValueObject> args;
+    args.push_back(NativeRdb::ValueObject(userId));
     if (!bundleName.empty() && !uid.empty()) {
-        sql = "SELECT user_id, bn, uid, time FROM " + ACCESS_RECORD_TABLE +
-              " WHERE user_id = ? AND bn = ? AND uid = ? AND time >= ?";
-        args.push_back(NativeRdb::ValueObject(userId));
+        sql += " AND bn = ? AND uid = ?";
         args.push_back(NativeRdb::ValueObject(bundleName));
         args.push_back(NativeRdb::ValueObject(uid));
-        args.push_back(NativeRdb::ValueObject(sevenDaysAgo));
-    } else {
-        sql = "SELECT user_id, bn, uid, time FROM " + ACCESS_RECORD_TABLE +
-              " WHERE user_id = ? AND time >= ?";
-        args.push_back(NativeRdb::ValueObject(userId));
-        args.push_back(NativeRdb::ValueObject(sevenDaysAgo));
     }
+    sql += " AND minute >= ? ORDER BY user_id, bn, uid, minute";
+    args.push_back(NativeRdb::ValueObject(sevenDaysAgoMinute));
     auto resultSet = rdbStore_->QuerySql(sql, args);
     if (resultSet == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Query result set is null");
@@ -286,91 +482,249 @@ std::vector<AncoAccessRecordInfo> OaidRdbManager::QueryAccessRecordsFromDatabase
     }
     while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
         int columnIndex = 0;
-        int32_t recordUserId;
-        std::string recordBundleName;
-        std::string recordUid;
-        int64_t timeValue = 0;
-        resultSet->GetInt(columnIndex++, recordUserId);
-        resultSet->GetString(columnIndex++, recordBundleName);
-        resultSet->GetString(columnIndex++, recordUid);
-        resultSet->GetLong(columnIndex++, timeValue);
+        int64_t firstTime = 0;
         AncoAccessRecordInfo info;
-        info.userId = recordUserId;
-        info.bundleName = recordBundleName;
-        info.uid = recordUid;
-        info.time = std::to_string(timeValue);
-        info.count = 1; // Initialize count to 1
-        result.push_back(info);
+        resultSet->GetInt(columnIndex++, info.userId);
+        resultSet->GetString(columnIndex++, info.bundleName);
+        resultSet->GetString(columnIndex++, info.uid);
+        resultSet->GetLong(columnIndex++, firstTime);
+        resultSet->GetInt(columnIndex++, info.count);
+        info.time = std::to_string(firstTime);
+        result.push_back(std::move(info));
     }
     resultSet->Close();
+    OAID_HILOGI(OAID_MODULE_SERVICE, "QueryAccessRecords success, count=%{public}zu", result.size());
     return result;
 }
 
-std::vector<AncoAccessRecordInfo> OaidRdbManager::ProcessAccessRecords(
-    const std::vector<AncoAccessRecordInfo>& records)
+int32_t OaidRdbManager::QueryAccessRecordsPage(int32_t userId, const std::string& bundleName,
+    const std::string& uid, const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page)
 {
-    std::vector<AncoAccessRecordInfo> result;
-    std::map<MinuteGroupKey, std::vector<std::pair<int64_t, int32_t>>> minuteGroups;
-    for (const auto& record : records) {
-        MinuteGroupKey key = {
-            .userId = record.userId,
-            .bundleName = record.bundleName,
-            .uid = record.uid,
-            .minuteGroup = std::stoll(record.time) / ONE_MINUTE_MS
-        };
-        minuteGroups[key].push_back({std::stoll(record.time), 1});
-    }
-    for (auto& pair : minuteGroups) {
-        auto& timeList = pair.second;
-        std::sort(timeList.begin(), timeList.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
-        std::vector<std::pair<int64_t, int32_t>> mergedList;
-        if (MergeTimeList(timeList, mergedList)) {
-            BuildAccessRecordInfo(pair.first, mergedList, result);
-        }
+    page.records.clear();
+    page.nextCursor.clear();
+    AccessRecordCursor after;
+    if (pageSize <= 0 || (!cursor.empty() && !DecodeAccessRecordCursor(cursor, after))) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid page request, pageSize=%{public}d", pageSize);
+        return ERR_INVALID_PARAM;
+    }
+    if (cursor.empty()) {
+        // Later pages continue from a key, the records journaled since then belong to the next first page.
+        FlushAccessRecords();
     }
-    return result;
-}
-
-std::vector<AncoAccessRecordInfo> OaidRdbManager::QueryAccessRecords(int32_t userId,
-    const std::string& bundleName, const std::string& uid)
-{
     std::shared_lock<std::shared_mutex> lock(mutex_);
-    std::vector<AncoAccessRecordInfo> result;
     if (rdbStore_ == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
-        return result;
+        return ERR_DB_CONNECT_FAILED;
     }
-    int64_t currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()).count();
-    int64_t sevenDaysAgo = currentTime - SEVEN_DAYS_MS;
-    // Query records from the database
-    std::vector<AncoAccessRecordInfo> records = QueryAccessRecordsFromDatabase(userId, bundleName, uid, sevenDaysAgo);
-    // Process the records
-    result = ProcessAccessRecords(records);
-    OAID_HILOGI(OAID_MODULE_SERVICE, "QueryAccessRecords success, count=%{public}zu", result.size());
-    return result;
+    int64_t sevenDaysAgoMinute = (GetCurrentTimeMs() - SEVEN_DAYS_MS) / ONE_MINUTE_MS;
+    std::string sql = "SELECT user_id, bn, uid, first_time, cnt FROM " + ACCESS_MINUTE_TABLE + " WHERE user_id = ?";
+    std::vector<NativeRdb::ValueObject> args;
+    args.push_back(NativeRdb::ValueObject(userId));
+    if (!bundleName.empty() && !uid.empty()) {
+        sql += " AND bn = ? AND uid = ?";
+        args.push_back(NativeRdb::ValueObject(bundleName));
+        args.push_back(NativeRdb::ValueObject(uid));
+    }
+    sql += " AND minute >= ?";
+    args.push_back(NativeRdb::ValueObject(sevenDaysAgoMinute));
+    if (!cursor.empty()) {
+        sql += " AND (first_time, bn, uid) < (?, ?, ?)";
+        args.push_back(NativeRdb::ValueObject(after.firstTime));
+        args.push_back(NativeRdb::ValueObject(after.bundleName));
+        args.push_back(NativeRdb::ValueObject(after.uid));
+    }
+    // One row past the page tells whether another page follows.
+    sql += " ORDER BY first_time DESC, bn DESC, uid DESC LIMIT ?";
+    args.push_back(NativeRdb::ValueObject(pageSize + 1));
+    auto resultSet = rdbStore_->QuerySql(sql, args);
+    if (resultSet == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Query result set is null");
+        return ERR_SYSYTEM_ERROR;
+    }
+    int64_t lastFirstTime = 0;
+    bool hasMore = false;
+    page.records.reserve(static_cast<size_t>(pageSize));
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        if (page.records.size() == static_cast<size_t>(pageSize)) {
+            hasMore = true;
+            break;
+        }
+        int columnIndex = 0;
+        AncoAccessRecordInfo info;
+        resultSet->GetInt(columnIndex++, info.userId);
+        resultSet->GetString(columnIndex++, info.bundleName);
+        resultSet->GetString(columnIndex++, info.uid);
+        resultSet->GetLong(columnIndex++, lastFirstTime);
+        resultSet->GetInt(columnIndex++, info.count);
+        info.time = std::to_string(lastFirstTime);
+        page.records.push_back(std::move(info));
+    }
+    resultSet->Close();
+    if (hasMore) {
+        const AncoAccessRecordInfo& last = page.records.back();
+        page.nextCursor = EncodeAccessRecordCursor(lastFirstTime, last.bundleName, last.uid);
+    }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "QueryAccessRecordsPage success, count=%{public}zu, hasMore=%{public}d",
+        page.records.size(), hasMore);
+    return ERR_OK;
 }
+
 int32_t OaidRdbManager::InsertAccessRecord(const int32_t userId, const std::string bundleName, const std::string uid)
+{
+    AccessRecordEntry entry;
+    entry.userId = userId;
+    entry.bundleName = bundleName;
+    entry.uid = uid;
+    entry.time = GetCurrentTimeMs();
+    size_t pendingCount = 0;
+    if (!journal_.Append(entry, pendingCount)) {
+        // Journal full (flusher behind) or not open: commit what is pending, then retry once.
+        FlushAccessRecords();
+        if (!journal_.Append(entry, pendingCount)) {
+            OAID_HILOGW(OAID_MODULE_SERVICE, "Journal access record failed, insert directly");
+            return InsertAccessRecordDirectly(entry);
+        }
+    }
+    ScheduleAccessRecordFlush(pendingCount >= ACCESS_RECORD_FLUSH_THRESHOLD);
+    return ERR_OK;
+}
+
+int32_t OaidRdbManager::InsertAccessRecordDirectly(const AccessRecordEntry& entry)
 {
     std::unique_lock<std::shared_mutex> lock(mutex_);
     if (rdbStore_ == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
         return ERR_DB_CONNECT_FAILED;
     }
-    int64_t currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    int err = rdbStore_->BeginTransaction();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to begin transaction, err=%{public}d", err);
+        return ERR_DB_CONNECT_FAILED;
+    }
+    if (InsertAccessRecordLocked(entry) != NativeRdb::E_OK || rdbStore_->Commit() != NativeRdb::E_OK) {
+        rdbStore_->RollBack();
+        return ERR_DB_CONNECT_FAILED;
+    }
+    return ERR_OK;
+}
+
+int OaidRdbManager::InsertAccessRecordLocked(const AccessRecordEntry& entry)
+{
     NativeRdb::ValuesBucket row;
-    row.PutInt("user_id", userId);
-    row.PutString("bn", bundleName);
-    row.PutString("uid", uid);
-    row.PutLong("time", currentTime);
+    row.PutInt("user_id", entry.userId);
+    row.PutString("bn", entry.bundleName);
+    row.PutString("uid", entry.uid);
+    row.PutLong("time", entry.time);
     int64_t outRowId = 0;
     int err = rdbStore_->Insert(outRowId, ACCESS_RECORD_TABLE, row);
     if (err != NativeRdb::E_OK) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to insert accessRecord, err=%{public}d", err);
+        return err;
+    }
+    err = rdbStore_->ExecuteSql(ACCESS_MINUTE_UPSERT_SQL,
+        BuildAccessMinuteArgs(entry.userId, entry.bundleName, entry.uid, entry.time));
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to update access minute, err=%{public}d", err);
+    }
+    return err;
+}
+
+void OaidRdbManager::ScheduleAccessRecordFlush(bool immediate)
+{
+    std::lock_guard<std::mutex> lock(flushTaskMutex_);
+    if (flushScheduled_ && (flushImmediate_ || !immediate)) {
+        return;
+    }
+    auto handler = GetWorkHandler();
+    if (flushScheduled_) {
+        // Size threshold reached while a timed flush is waiting: bring it forward.
+        handler->RemoveTask(ACCESS_RECORD_FLUSH_TASK);
+    }
+    auto task = [this]() {
+        {
+            std::lock_guard<std::mutex> lock(flushTaskMutex_);
+            flushScheduled_ = false;
+            flushImmediate_ = false;
+        }
+        if (FlushAccessRecords() == ERR_OK) {
+            return;
+        }
+        // Keep the records journaled and try again later.
+        ScheduleAccessRecordFlush(false);
+    };
+    flushScheduled_ = handler->PostTask(task, ACCESS_RECORD_FLUSH_TASK,
+        immediate ? 0 : ACCESS_RECORD_FLUSH_DELAY_MS);
+    flushImmediate_ = flushScheduled_ && immediate;
+    if (!flushScheduled_) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Post access record flush task failed");
+    }
+}
+
+std::shared_ptr<AppExecFwk::EventHandler> OaidRdbManager::GetWorkHandler()
+{
+    std::lock_guard<std::mutex> lock(workHandlerMutex_);
+    if (workHandler_ == nullptr) {
+        auto runner = AppExecFwk::EventRunner::Create("oaid_access_record");
+        workHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    }
+    return workHandler_;
+}
+
+int32_t OaidRdbManager::FlushAccessRecords()
+{
+    std::lock_guard<std::mutex> flushLock(flushMutex_);
+    std::vector<AccessRecordEntry> batch;
+    while (journal_.PeekBatch(batch, ACCESS_RECORD_FLUSH_BATCH_SIZE) > 0) {
+        int32_t ret = ERR_OK;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            ret = CommitAccessRecordsLocked(batch);
+        }
+        if (ret != ERR_OK) {
+            return ret;
+        }
+        journal_.Release(batch.size());
+    }
+    return ERR_OK;
+}
+
+int32_t OaidRdbManager::FlushAccessRecordsLocked()
+{
+    std::vector<AccessRecordEntry> batch;
+    while (journal_.PeekBatch(batch, ACCESS_RECORD_FLUSH_BATCH_SIZE) > 0) {
+        int32_t ret = CommitAccessRecordsLocked(batch);
+        if (ret != ERR_OK) {
+            return ret;
+        }
+        journal_.Release(batch.size());
+    }
+    return ERR_OK;
+}
+
+int32_t OaidRdbManager::CommitAccessRecordsLocked(const std::vector<AccessRecordEntry>& batch)
+{
+    if (rdbStore_ == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
+        return ERR_DB_CONNECT_FAILED;
+    }
+    int err = rdbStore_->BeginTransaction();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to begin transaction, err=%{public}d", err);
+        return ERR_DB_CONNECT_FAILED;
+    }
+    for (const auto& entry : batch) {
+        if (InsertAccessRecordLocked(entry) != NativeRdb::E_OK) {
+            rdbStore_->RollBack();
+            return ERR_DB_CONNECT_FAILED;
+        }
+    }
+    err = rdbStore_->Commit();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to commit access records, err=%{public}d", err);
+        rdbStore_->RollBack();
         return ERR_DB_CONNECT_FAILED;
     }
-    OAID_HILOGI(OAID_MODULE_SERVICE, "InsertAccessRecord success");
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Commit access records success, count=%{public}zu", batch.size());
     return ERR_OK;
 }
 
@@ -402,38 +756,156 @@ std::vector<std::string> OaidRdbManager::QueryAllBundleNames(int32_t userId)
     return bundleNames;
 }
 
-int32_t OaidRdbManager::CleanUninstalledAppRecords(int32_t userId)
+std::vector<int32_t> OaidRdbManager::QueryAllUserIds()
 {
-    std::vector<std::string> allBundleNames = QueryAllBundleNames(userId);
-    if (allBundleNames.empty()) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<int32_t> userIds;
+    if (rdbStore_ == nullptr) {
+        return userIds;
+    }
+    auto resultSet = rdbStore_->QuerySql("SELECT user_id FROM " + SWITCH_STATUS_TABLE +
+        " UNION SELECT user_id FROM " + ACCESS_MINUTE_TABLE, {});
+    if (resultSet == nullptr) {
+        return userIds;
+    }
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        int32_t userId = 0;
+        resultSet->GetInt(0, userId);
+        userIds.push_back(userId);
+    }
+    resultSet->Close();
+    return userIds;
+}
+
+void OaidRdbManager::SchedulePurgeBundle(int32_t userId, const std::string& bundleName)
+{
+    auto task = [this, userId, bundleName]() {
+        if (Init() == ERR_OK) {
+            PurgeBundleRecords(userId, { bundleName });
+        }
+    };
+    if (!GetWorkHandler()->PostTask(task, PURGE_BUNDLE_TASK)) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Post purge bundle task failed");
+    }
+}
+
+void OaidRdbManager::SchedulePurgeUser(int32_t userId)
+{
+    auto task = [this, userId]() {
+        if (Init() == ERR_OK) {
+            PurgeUserRecords(userId);
+        }
+    };
+    if (!GetWorkHandler()->PostTask(task, PURGE_USER_TASK)) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Post purge user task failed");
+    }
+}
+
+int32_t OaidRdbManager::ReconcileUninstalledAppRecords(int32_t userId)
+{
+    std::vector<std::string> trackedBundles = QueryAllBundleNames(userId);
+    if (trackedBundles.empty()) {
+        return ERR_OK;
+    }
+    std::vector<AppExecFwk::BundleInfo> bundleInfos;
+    // BMS 不可用时不能把所有应用都当作已卸载
+    if (!BundleMgrHelper::GetInstance()->GetBundleInfosV9ByReqPermission(bundleInfos, userId)) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Get installed bundles failed, skip reconcile of user %{public}d", userId);
+        return ERR_SYSYTEM_ERROR;
+    }
+    // An empty list is what a BMS that is still starting, or a user being removed, answers. Purging on it would
+    // drop every tracked app of the user; real uninstalls are still caught by the package removed event.
+    if (bundleInfos.empty()) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "No installed bundles reported, skip reconcile of user %{public}d", userId);
         return ERR_OK;
     }
+    std::unordered_set<std::string> installedBundles;
+    installedBundles.reserve(bundleInfos.size());
+    for (const auto& bundleInfo : bundleInfos) {
+        installedBundles.insert(bundleInfo.name);
+    }
     std::vector<std::string> uninstalledBundles;
-    for (const auto& bundleName : allBundleNames) {
-        AppExecFwk::BundleInfo bundleInfo;
-            if (uninstalledBundles.size() < MAX_DELETE_COUNT &&
-                !BundleMgrHelper::GetInstance()->GetBundleInfo(bundleName, bundleInfo, userId)) {
-                uninstalledBundles.push_back(bundleName);
-            }
+    for (const auto& bundleName : trackedBundles) {
+        if (installedBundles.find(bundleName) == installedBundles.end()) {
+            uninstalledBundles.push_back(bundleName);
+        }
     }
     if (uninstalledBundles.empty()) {
         return ERR_OK;
     }
+    return PurgeBundleRecords(userId, uninstalledBundles);
+}
+
+int32_t OaidRdbManager::PurgeBundleRecords(int32_t userId, const std::vector<std::string>& bundleNames)
+{
+    // Journaled records of the bundles must not come back after the purge.
+    FlushAccessRecords();
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    auto [switchDeleteSql, switchArgs] = BuildBatchDeleteSql(userId, SWITCH_STATUS_TABLE, uninstalledBundles);
-    int32_t ret = rdbStore_->ExecuteSql(switchDeleteSql, switchArgs);
-    if (ret != NativeRdb::E_OK) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to batch delete switch status, ret=%{public}d", ret);
+    if (rdbStore_ == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
+        return ERR_DB_CONNECT_FAILED;
+    }
+    int err = rdbStore_->BeginTransaction();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to begin transaction, err=%{public}d", err);
         return ERR_DB_CONNECT_FAILED;
     }
-    auto [recordDeleteSql, recordArgs] = BuildBatchDeleteSql(userId, ACCESS_RECORD_TABLE, uninstalledBundles);
-    ret = rdbStore_->ExecuteSql(recordDeleteSql, recordArgs);
-    if (ret != NativeRdb::E_OK) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to batch delete access records, ret=%{public}d", ret);
+    for (size_t begin = 0; begin < bundleNames.size(); begin += MAX_DELETE_COUNT) {
+        std::vector<std::string> chunk(bundleNames.begin() + begin,
+            bundleNames.begin() + std::min(bundleNames.size(), begin + MAX_DELETE_COUNT));
+        for (const auto& tableName : { SWITCH_STATUS_TABLE, ACCESS_RECORD_TABLE, ACCESS_MINUTE_TABLE }) {
+            auto [sql, args] = BuildBatchDeleteSql(userId, tableName, chunk);
+            err = rdbStore_->ExecuteSql(sql, args);
+            if (err != NativeRdb::E_OK) {
+                OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to purge %{public}s, err=%{public}d", tableName.c_str(),
+                    err);
+                rdbStore_->RollBack();
+                return ERR_DB_CONNECT_FAILED;
+            }
+        }
+    }
+    err = rdbStore_->Commit();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to commit purge, err=%{public}d", err);
+        rdbStore_->RollBack();
+        return ERR_DB_CONNECT_FAILED;
+    }
+    switchStatusCache_.EraseBundles(userId, bundleNames);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Purge uninstalled bundles success, userId=%{public}d, count=%{public}zu",
+        userId, bundleNames.size());
+    return ERR_OK;
+}
+
+int32_t OaidRdbManager::PurgeUserRecords(int32_t userId)
+{
+    FlushAccessRecords();
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (rdbStore_ == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
+        return ERR_DB_CONNECT_FAILED;
+    }
+    int err = rdbStore_->BeginTransaction();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to begin transaction, err=%{public}d", err);
+        return ERR_DB_CONNECT_FAILED;
+    }
+    for (const auto& tableName : { SWITCH_STATUS_TABLE, ACCESS_RECORD_TABLE, ACCESS_MINUTE_TABLE }) {
+        err = rdbStore_->ExecuteSql("DELETE FROM " + tableName + " WHERE user_id = ?",
+            { NativeRdb::ValueObject(userId) });
+        if (err != NativeRdb::E_OK) {
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to purge %{public}s, err=%{public}d", tableName.c_str(), err);
+            rdbStore_->RollBack();
+            return ERR_DB_CONNECT_FAILED;
+        }
+    }
+    err = rdbStore_->Commit();
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to commit purge, err=%{public}d", err);
+        rdbStore_->RollBack();
         return ERR_DB_CONNECT_FAILED;
     }
-    OAID_HILOGI(OAID_MODULE_SERVICE, "CleanUninstalledAppRecords success, cleaned=%{public}zu",
-        uninstalledBundles.size());
+    switchStatusCache_.EraseUser(userId);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Purge removed user success, userId=%{public}d", userId);
     return ERR_OK;
 }
 
@@ -454,26 +926,81 @@ std::pair<std::string, std::vector<NativeRdb::ValueObject>> OaidRdbManager::Buil
     return std::make_pair(sql, args);
 }
 
-int32_t OaidRdbManager::CleanExpiredAccessRecords(int32_t userId)
+int32_t OaidRdbManager::DeleteExpiredAccessRecords(int32_t userId, int64_t cutoffMs, size_t limit,
+    size_t& deleted, bool& hasMore)
 {
+    deleted = 0;
+    hasMore = false;
     std::unique_lock<std::shared_mutex> lock(mutex_);
     if (rdbStore_ == nullptr) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "RDB not initialized");
         return ERR_DB_CONNECT_FAILED;
     }
-    int64_t currentTime = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
-    int64_t tenDaysAgo = currentTime - TEN_DAYS_MS;
-    NativeRdb::RdbPredicates predicates(ACCESS_RECORD_TABLE);
-    predicates.EqualTo("user_id", NativeRdb::ValueObject(userId));
-    predicates.LessThan("time", NativeRdb::ValueObject(tenDaysAgo));
+    // Both sub-selects walk the (user_id, time) indexes, so a chunk never scans the table.
     int deletedRows = 0;
-    int32_t ret = rdbStore_->Delete(deletedRows, predicates);
-    if (ret != NativeRdb::E_OK) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to clean expired access records, ret=%{public}d", ret);
+    int err = rdbStore_->Delete(deletedRows, ACCESS_RECORD_TABLE, "id IN (SELECT id FROM " + ACCESS_RECORD_TABLE +
+        " WHERE user_id = ? AND time < ? LIMIT ?)",
+        { NativeRdb::ValueObject(userId), NativeRdb::ValueObject(cutoffMs),
+          NativeRdb::ValueObject(static_cast<int64_t>(limit)) });
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to delete expired access records, err=%{public}d", err);
+        return ERR_DB_CONNECT_FAILED;
+    }
+    int deletedMinutes = 0;
+    err = rdbStore_->Delete(deletedMinutes, ACCESS_MINUTE_TABLE, "rowid IN (SELECT rowid FROM " +
+        ACCESS_MINUTE_TABLE + " WHERE user_id = ? AND first_time < ? LIMIT ?)",
+        { NativeRdb::ValueObject(userId), NativeRdb::ValueObject(cutoffMs),
+          NativeRdb::ValueObject(static_cast<int64_t>(limit)) });
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to delete expired access minutes, err=%{public}d", err);
+        return ERR_DB_CONNECT_FAILED;
+    }
+    deleted = static_cast<size_t>(deletedRows) + static_cast<size_t>(deletedMinutes);
+    hasMore = static_cast<size_t>(deletedRows) == limit || static_cast<size_t>(deletedMinutes) == limit;
+    return ERR_OK;
+}
+
+int32_t OaidRdbManager::GetPageCounts(int64_t& pageCount, int64_t& freelistCount)
+{
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (rdbStore_ == nullptr) {
+        return ERR_DB_CONNECT_FAILED;
+    }
+    if (rdbStore_->ExecuteAndGetLong(pageCount, "PRAGMA page_count") != NativeRdb::E_OK ||
+        rdbStore_->ExecuteAndGetLong(freelistCount, "PRAGMA freelist_count") != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to read page counts");
+        return ERR_DB_CONNECT_FAILED;
+    }
+    return ERR_OK;
+}
+
+int32_t OaidRdbManager::Vacuum()
+{
+    // Every transaction runs under the exclusive lock, so none is open while VACUUM holds it.
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (rdbStore_ == nullptr) {
+        return ERR_DB_CONNECT_FAILED;
+    }
+    int err = rdbStore_->ExecuteSql("VACUUM");
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "VACUUM failed, err=%{public}d", err);
+        return ERR_DB_CONNECT_FAILED;
+    }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "VACUUM success");
+    return ERR_OK;
+}
+
+int32_t OaidRdbManager::Analyze()
+{
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (rdbStore_ == nullptr) {
+        return ERR_DB_CONNECT_FAILED;
+    }
+    int err = rdbStore_->ExecuteSql("ANALYZE");
+    if (err != NativeRdb::E_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "ANALYZE failed, err=%{public}d", err);
         return ERR_DB_CONNECT_FAILED;
     }
-    OAID_HILOGI(OAID_MODULE_SERVICE, "CleanExpiredAccessRecords success, deletedRows=%{public}d", deletedRows);
     return ERR_OK;
 }
 
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_reset_listener_proxy.h"
+#include "oaid_common.h"
+
+namespace OHOS {
+namespace Cloud {
+OaidResetListenerProxy::OaidResetListenerProxy(const sptr<IRemoteObject> &impl)
+    : IRemoteProxy<IOaidResetListener>(impl)
+{}
+
+void OaidResetListenerProxy::OnOaidReset(uint64_t generation)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    if (!data.WriteInterfaceToken(GetDescriptor())) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "WriteInterfaceToken data fail");
+        return;
+    }
+    if (!data.WriteUint64(generation)) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "WriteUint64 failed.");
+        return;
+    }
+    sptr<IRemoteObject> remote = Remote();
+    if (remote == nullptr) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "remote is null");
+        return;
+    }
+    int ret = remote->SendRequest(static_cast<uint32_t>(ResetListenerCode::ON_OAID_RESET), data, reply, option);
+    if (ret != ERR_OK) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "OnOaidReset failed, error code: %{public}d", ret);
+    }
+}
+}  // namespace Cloud
+}  // namespace OHOS
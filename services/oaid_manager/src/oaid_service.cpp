@@ -14,12 +14,15 @@
  */
 #include "oaid_service.h"
 #include <mutex>
-#include <openssl/rand.h>
 #include <singleton.h>
 #include <string>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
 #include <ctime>
-#include <future>
 #include "oaid_common.h"
 #include "oaid_file_operator.h"
 #include "system_ability.h"
@@ -31,78 +34,65 @@
 #include "connect_ads_stub.h"
 #include "oaid_anco_service.h"
 #include "oaid_rdb_manager.h"
+#include "oaid_rdb_maintenance.h"
+#include "oaid_uuid_generator.h"
+#include "oaid_package_event_subscriber.h"
+#include "oaid_permission_usage_reporter.h"
+#include "oaid_config_manager.h"
+#include "oaid_kv_state_store.h"
+#include "oaid_file_state_store.h"
+#include "oaid_importing_state_store.h"
+
+#ifndef OAID_STATE_STORE_DEFAULT_BACKEND
+#define OAID_STATE_STORE_DEFAULT_BACKEND "kv"
+#endif
 
 using namespace std::chrono;
 
 namespace OHOS {
 namespace Cloud {
-const std::string OAID_VIRTUAL_STR = "-****-****-****-************";
+REGISTER_SYSTEM_ABILITY_BY_ID(OAIDService, OAID_SYSTME_ID, true);
+std::mutex OAIDService::mutex_;
+sptr<OAIDService> OAIDService::instance_;
+std::atomic<bool> OAIDService::oaidKvStoreExist;
+std::shared_ptr<const OaidValue> OAIDService::oaidSnapshot_;
+// Seeded with the start time so the generation keeps increasing across SA restarts.
+std::atomic<uint64_t> OAIDService::oaidGeneration_ {static_cast<uint64_t>(
+    duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count())};
+std::mutex OAIDService::updateMutex_;
+std::mutex OAIDService::persistHandlerMutex_;
+std::shared_ptr<AppExecFwk::EventHandler> OAIDService::persistHandler_;
+std::once_flag OAIDService::stateStoreOnce_;
+OaidStateStoreBackend OAIDService::stateStoreBackend_ = OaidStateStoreBackend::KV;
+std::shared_ptr<IOaidStateStore> OAIDService::oaidStateStore_;
+std::shared_ptr<IOaidStateStore> OAIDService::underAgeStateStore_;
+std::mutex OAIDService::kvStoreMutex_;
+std::condition_variable OAIDService::kvStoreCond_;
+OAIDService::KvStoreSlot OAIDService::oaidKvStoreSlot_;
+OAIDService::KvStoreSlot OAIDService::underAgeKvStoreSlot_;
+bool OAIDService::kvWarmUpStopping_ = false;
+std::vector<std::thread> OAIDService::kvWarmUpThreads_;
+
 namespace {
-char HexToChar(uint8_t hex)
+const std::string OAID_STATE_FILE_SUFFIX = ".state";
+constexpr mode_t OAID_STATE_DIR_MODE = 0700;
+
+std::vector<std::string> GetOaidStateKeys()
 {
-    static const uint8_t MAX_SINGLE_DIGIT = 9;  // 9 is the largest single digit
-    return (hex > MAX_SINGLE_DIGIT) ? (hex + 0x57) : (hex + 0x30);
+    return { OAID_KVSTORE_KEY };
 }
 
-/**
- * Get v4 uuid.
- *
- * @return std::string, uuid.
- */
-std::string GetUUID()
-{
-    static const int8_t UUID_LENGTH = 16;    // The UUID is 128 bits, that is 16 bytes.
-    static const int8_t VERSION_INDEX = 6;   // Obtain the seventh byte of the randomly generated UUID, that is uuid[6].
-    static const int8_t CHAR_LOW_WIDTH = 4;  // Lower 4 bits of the char type
-    static const int8_t N_INDEX = 8;         // Reset the ninth byte of the UUID, that is UUID[8].
-    unsigned char uuid[UUID_LENGTH] = {0};
-    if (RAND_bytes(uuid, sizeof(uuid)) != 1) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "RAND_bytes failed, using fallback");
-        return "";
-    }
+std::vector<std::string> GetUnderAgeStateKeys()
+{
+    return { UNDER_AGE_STATE_KEY, ALLOW_GET_OAID_KEY, LAST_UPDATE_TIME_KEY };
+}
 
-    /**
-     * xxxxxxxx-xxxx-Mxxx-Nxxx-xxxxxxxxxxxx
-     * M is uuid version: 4
-     * N is 8,9,a,b
-     */
-    uuid[VERSION_INDEX] = (uuid[VERSION_INDEX] & 0x0F) | 0x40;
-    int minN = 0x8;
-    int maxN = 0xb;
-    unsigned char randNumber[1] = {minN};
-    if (RAND_bytes(randNumber, sizeof(randNumber)) != 1) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "RAND_bytes for variant failed, using fallback");
-        return "";
-    }
-    unsigned char num = static_cast<unsigned char>(randNumber[0] % (maxN - minN + 1) + minN);
-    uuid[N_INDEX] = (uuid[N_INDEX] & 0x0F) | (num << CHAR_LOW_WIDTH);
-
-    static const size_t LINE_INDEX_MAX = 10;  // until i=10
-    static const size_t LINE_INDEX_MIN = 4;   // Add a hyphen (-) every two bytes starting from i=4.
-    static const size_t EVEN_FACTOR = 2;  // the even factor is assigned to 2, and all even numbers are divisible by 2.
-    std::string formatUuid = "";
-    for (size_t i = 0; i < sizeof(uuid); i++) {
-        unsigned char value = uuid[i];
-        if (i >= LINE_INDEX_MIN && i <= LINE_INDEX_MAX && i % EVEN_FACTOR == 0) {
-            formatUuid += "-";
-        }
-        formatUuid += HexToChar(value >> CHAR_LOW_WIDTH);
-        unsigned char highValue = value & 0xF0;
-        if (highValue == 0) {
-            formatUuid += HexToChar(value);
-        } else {
-            formatUuid += HexToChar(value % (value & highValue));
-        }
-    }
-    return formatUuid;
+int64_t GetSteadyTimeMs()
+{
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
 }
 }  // namespace
 
-REGISTER_SYSTEM_ABILITY_BY_ID(OAIDService, OAID_SYSTME_ID, true);
-std::mutex OAIDService::mutex_;
-sptr<OAIDService> OAIDService::instance_;
-std::atomic<bool> OAIDService::oaidKvStoreExist;
-
 OAIDService::OAIDService(int32_t systemAbilityId, bool runOnCreate)
     : SystemAbility(systemAbilityId, runOnCreate), state_(ServiceRunningState::STATE_NOT_START)
 {
@@ -133,11 +123,20 @@ void OAIDService::OnStart()
         return;
     }
 
+    // Open the kv stores while the SA is being published, so the first request does not pay for it.
+    if (GetStateStoreBackend() == OaidStateStoreBackend::KV) {
+        StartKvStoreWarmUp();
+    }
     if (Init() != ERR_OK) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Init failed, Try again 10s later.");
         return;
     }
     AddSystemAbilityListener(OAID_SYSTME_ID);
+    AddSystemAbilityListener(COMMON_EVENT_SERVICE_ID);
+    // The RDB stays open across OnStop / OnStart in one process, its Init does not start maintenance again.
+    if (OaidRdbManager::GetInstance().IsReady()) {
+        OaidRdbMaintenance::GetInstance().Start();
+    }
 
     OAID_HILOGI(OAID_MODULE_SERVICE, "Start OAID OK");
     return;
@@ -162,139 +161,266 @@ void OAIDService::OnStop()
         return;
     }
 
+    OaidPackageEventSubscriber::Unsubscribe();
+    WaitPersistOAIDTasks();
+    StopKvStoreWarmUp();
+    // Anything left is replayed from the journal by the next Init, flushing here only saves that work.
+    OaidRdbMaintenance::GetInstance().Stop();
+    OaidRdbManager::GetInstance().FlushAccessRecords();
+    OaidPermissionUsageReporter::GetInstance().Flush();
     state_ = ServiceRunningState::STATE_NOT_START;
     OAID_HILOGI(OAID_MODULE_SERVICE, "Stop success.");
 }
 
+int OAIDService::Dump(int fd, const std::vector<std::u16string> &args)
+{
+    if (fd < 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Dump fd invalid");
+        return ERR_INVALID_PARAM;
+    }
+    OaidRdbMaintenanceStats stats = OaidRdbMaintenance::GetInstance().GetStats();
+    std::string info;
+    info.append("State store backend: ").append(GetOaidStateStoreBackendName(GetStateStoreBackend())).append("\n");
+    info.append("RDB maintenance:\n");
+    info.append("  lastRunTimeMs: ").append(std::to_string(stats.lastRunTimeMs)).append("\n");
+    info.append("  lastRunDurationMs: ").append(std::to_string(stats.lastRunDurationMs)).append("\n");
+    info.append("  lastRemovedRows: ").append(std::to_string(stats.lastRemovedRows)).append("\n");
+    info.append("  totalRemovedRows: ").append(std::to_string(stats.totalRemovedRows)).append("\n");
+    info.append("  lastAnalyzeTimeMs: ").append(std::to_string(stats.lastAnalyzeTimeMs)).append("\n");
+    info.append("  lastVacuumTimeMs: ").append(std::to_string(stats.lastVacuumTimeMs)).append("\n");
+    if (dprintf(fd, "%s", info.c_str()) < 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Dump write failed, errno=%{public}d", errno);
+        return ERR_SYSYTEM_ERROR;
+    }
+    return ERR_OK;
+}
+
 void OAIDService::OnAddSystemAbility(int32_t systemAbilityId, const std::string &deviceId)
 {
     switch (systemAbilityId) {
         case OAID_SYSTME_ID:
             OAID_HILOGI(OAID_MODULE_SERVICE, "OnAddSystemAbility enter");
             break;
+        case COMMON_EVENT_SERVICE_ID:
+            OaidPackageEventSubscriber::Subscribe();
+            break;
         default:
             OAID_HILOGI(OAID_MODULE_SERVICE, "sa unhandled sysabilityId: %{public}d", systemAbilityId);
             break;
     }
 }
 
-bool OAIDService::CheckKvStore()
+OaidStateStoreBackend OAIDService::GetStateStoreBackend()
 {
-    if (oaidKvStore_ != nullptr) {
-        return true;
-    }
-    bool result = InitKvStore(OAID_DATA_BASE_STORE_ID);
-    oaidKvStoreExist = result;
-    OAID_HILOGI(OAID_MODULE_SERVICE, "InitOaidKvStore: %{public}s", result == true ? "success" : "failed");
-    return result;
+    std::call_once(stateStoreOnce_, &OAIDService::InitStateStores);
+    return stateStoreBackend_;
 }
 
-bool OAIDService::ReadValueFromKvStore(const std::string &kvStoreKey, std::string &kvStoreValue)
+void OAIDService::InitStateStores()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if (!CheckKvStore()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "ReadValueFromKvStore:oaidKvStore_ is nullptr");
-        return false;
-    }
-
-    DistributedKv::Key key(kvStoreKey);
-    DistributedKv::Value value;
-    DistributedKv::Status status = oaidKvStore_->Get(key, value);
-    if (status == DistributedKv::Status::SUCCESS) {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "%{public}d get value from kvStore", status);
+    OaidStateStoreBackend backend = OaidStateStoreBackend::KV;
+    if (!ParseOaidStateStoreBackend(OAID_STATE_STORE_DEFAULT_BACKEND, backend)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Unknown default state store backend, use kv");
+    }
+    auto config = OaidConfigManager::GetInstance().GetConfig();
+    if (config != nullptr && config->stateStoreBackend.has_value() &&
+        !ParseOaidStateStoreBackend(config->stateStoreBackend.value(), backend)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Unknown stateStoreBackend %{public}s, ignored",
+            config->stateStoreBackend.value().c_str());
+    }
+
+    std::string stateDir = OAID_DATA_BASE_DIR + OAID_DATA_BASE_APP_ID;
+    std::string oaidStatePath = stateDir + "/" + OAID_DATA_BASE_STORE_ID + OAID_STATE_FILE_SUFFIX;
+    std::string underAgeStatePath = stateDir + "/" + OAID_UNDER_AGE_STORE_ID + OAID_STATE_FILE_SUFFIX;
+    std::shared_ptr<IOaidStateStore> oaidKvStore = std::make_shared<OaidKvStateStore>(OAID_DATA_BASE_STORE_ID,
+        []() { return AcquireKvStore(OAID_DATA_BASE_STORE_ID); });
+    std::shared_ptr<IOaidStateStore> underAgeKvStore = std::make_shared<OaidKvStateStore>(OAID_UNDER_AGE_STORE_ID,
+        []() { return AcquireKvStore(OAID_UNDER_AGE_STORE_ID); });
+    if (backend == OaidStateStoreBackend::KV) {
+        oaidStateStore_ = oaidKvStore;
+        underAgeStateStore_ = underAgeKvStore;
+        // Only a device that ran the file backend before has state files to take over.
+        if (access(oaidStatePath.c_str(), F_OK) == 0 || access(underAgeStatePath.c_str(), F_OK) == 0) {
+            oaidStateStore_ = std::make_shared<OaidImportingStateStore>(oaidKvStore,
+                std::make_shared<OaidFileStateStore>(oaidStatePath), GetOaidStateKeys());
+            underAgeStateStore_ = std::make_shared<OaidImportingStateStore>(underAgeKvStore,
+                std::make_shared<OaidFileStateStore>(underAgeStatePath), GetUnderAgeStateKeys());
+        }
     } else {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "%{public}d get value from kvStore failed", status);
-        return false;
-    }
-    kvStoreValue = value.ToString();
-
-    return true;
+        if (mkdir(stateDir.c_str(), OAID_STATE_DIR_MODE) != 0 && errno != EEXIST) {
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Create state dir failed, errno=%{public}d", errno);
+        }
+        oaidStateStore_ = std::make_shared<OaidImportingStateStore>(
+            std::make_shared<OaidFileStateStore>(oaidStatePath), oaidKvStore, GetOaidStateKeys());
+        underAgeStateStore_ = std::make_shared<OaidImportingStateStore>(
+            std::make_shared<OaidFileStateStore>(underAgeStatePath), underAgeKvStore, GetUnderAgeStateKeys());
+        // The file backend is always available, GetAncoOAID must not wait for a kv store that is never opened.
+        oaidKvStoreExist = true;
+    }
+    stateStoreBackend_ = backend;
+    OAID_HILOGI(OAID_MODULE_SERVICE, "State store backend: %{public}s", GetOaidStateStoreBackendName(backend));
 }
 
-bool OAIDService::WriteValueToKvStore(const std::string &kvStoreKey, const std::string &kvStoreValue)
+std::shared_ptr<IOaidStateStore> OAIDService::GetStateStore(const std::string &storeId)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    GetStateStoreBackend();
+    return (storeId == OAID_UNDER_AGE_STORE_ID) ? underAgeStateStore_ : oaidStateStore_;
+}
 
-    if (!CheckKvStore()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "WriteValueToKvStore:oaidKvStore_ is nullptr");
-        return false;
-    }
+OaidStateStoreStatus OAIDService::ReadValueFromKvStore(const std::string &kvStoreKey, std::string &kvStoreValue)
+{
+    std::vector<uint8_t> value;
+    OaidStateStoreStatus status = GetStateStore(OAID_DATA_BASE_STORE_ID)->Get(kvStoreKey, value);
+    if (status != OaidStateStoreStatus::SUCCESS) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "ReadValueFromKvStore failed, status=%{public}d", static_cast<int>(status));
+        return status;
+    }
+    kvStoreValue.assign(value.begin(), value.end());
+    return OaidStateStoreStatus::SUCCESS;
+}
 
-    DistributedKv::Key key(kvStoreKey);
-    DistributedKv::Value value(kvStoreValue);
-    DistributedKv::Status status = oaidKvStore_->Put(key, value);
-    if (status == DistributedKv::Status::SUCCESS) {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "%{public}d updated to kvStore", status);
-    } else {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "%{public}d update to kvStore failed", status);
+bool OAIDService::WriteValueToKvStore(const std::string &kvStoreKey, const std::string &kvStoreValue)
+{
+    std::vector<uint8_t> value(kvStoreValue.begin(), kvStoreValue.end());
+    if (!GetStateStore(OAID_DATA_BASE_STORE_ID)->Put(kvStoreKey, value)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "WriteValueToKvStore failed");
         return false;
     }
-
     return true;
 }
 
-std::string OAIDService::GainOAID()
+OaidValue OAIDService::GainOAID()
 {
-    std::string oaidKvStoreStr = OAID_ALLZERO_STR;
     if (!ConnectAdsManager::GetInstance()->checkAllowGetOaid()) {
         OAID_HILOGI(OAID_MODULE_SERVICE, "under age, not allow get oaid");
-        return OAID_ALLZERO_STR;
+        return OaidValue();
     }
-    std::lock_guard<std::mutex> lock(updateMutex_);
-    bool result = ReadValueFromKvStore(OAID_KVSTORE_KEY, oaidKvStoreStr);
+    auto snapshot = std::atomic_load_explicit(&oaidSnapshot_, std::memory_order_acquire);
+    if (snapshot != nullptr) {
+        return *snapshot;
+    }
+    return LoadOrCreateOAID();
+}
 
-    if (oaidKvStoreStr != OAID_ALLZERO_STR && !oaidKvStoreStr.empty()) {
-        if (oaid_.empty()) {
-            oaid_ = oaidKvStoreStr;
+OaidValue OAIDService::LoadOrCreateOAID()
+{
+    std::lock_guard<std::mutex> lock(updateMutex_);
+    // Another binder thread may have published the snapshot while this one waited for the lock.
+    auto snapshot = std::atomic_load_explicit(&oaidSnapshot_, std::memory_order_acquire);
+    if (snapshot != nullptr) {
+        return *snapshot;
+    }
+
+    std::string oaidKvStoreStr;
+    OaidValue oaid;
+    OaidStateStoreStatus status = ReadValueFromKvStore(OAID_KVSTORE_KEY, oaidKvStoreStr);
+    if (status == OaidStateStoreStatus::ERROR) {
+        // The store may still hold the OAID (kv store not open yet, transient failure): generating one here would
+        // overwrite it. Nothing is published, so the next call reads again.
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Read oaid from store failed, retry on next call");
+        return OaidValue();
+    }
+    if (status == OaidStateStoreStatus::SUCCESS) {
+        if (OaidValue::FromString(oaidKvStoreStr, oaid) && !oaid.IsZero()) {
             OAID_HILOGI(OAID_MODULE_SERVICE, "Oaid in the memory is empty");
+            PublishOAID(oaid);
+            return oaid;
         }
-        return oaid_;
-    } else {
-        if (oaid_.empty()) {
-            oaid_ = GetUUID();
-            if (oaid_.empty()) {
-                OAID_HILOGI(OAID_MODULE_SERVICE, "Oaid get uuid is empty");
-                return OAID_ALLZERO_STR;
-            }
-            OAID_HILOGI(OAID_MODULE_SERVICE, "The oaid has been regenerated.");
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Oaid in kvStore is malformed, regenerate it");
+    }
+
+    if (!OaidUuidGenerator::GetInstance().Generate(oaid)) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "Oaid get uuid is empty");
+        return OaidValue();
+    }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "The oaid has been regenerated.");
+    // The snapshot is served for the life of the process, it must never hold an OAID the store does not have.
+    if (!WriteValueToKvStore(OAID_KVSTORE_KEY, oaid.ToString())) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "WriteValueToKvStore failed, oaid not published");
+        return OaidValue();
+    }
+    PublishOAID(oaid);
+    return oaid;
+}
+
+void OAIDService::PublishOAID(const OaidValue &oaid)
+{
+    std::atomic_store_explicit(&oaidSnapshot_, std::make_shared<const OaidValue>(oaid), std::memory_order_release);
+}
+
+void OAIDService::PostPersistOAIDTask(const OaidValue &oaid)
+{
+    {
+        std::lock_guard<std::mutex> lock(persistHandlerMutex_);
+        if (persistHandler_ == nullptr) {
+            auto runner = AppExecFwk::EventRunner::Create("oaid_persist");
+            persistHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
         }
     }
-    result = WriteValueToKvStore(OAID_KVSTORE_KEY, oaid_);
-    OAID_HILOGI(OAID_MODULE_SERVICE, "WriteValueToKvStore %{public}s", result == true ? "success" : "failed");
-    return oaid_;
+    auto task = [this, oaid]() {
+        bool result = WriteValueToKvStore(OAID_KVSTORE_KEY, oaid.ToString());
+        OAID_HILOGI(OAID_MODULE_SERVICE, "Persist oaid WriteValueToKvStore %{public}s",
+            result == true ? "success" : "failed");
+    };
+    if (!persistHandler_->PostTask(task)) {
+        OAID_HILOGW(OAID_MODULE_SERVICE, "Post persist oaid task failed, write inline");
+        task();
+    }
 }
 
-std::string OAIDService::GetOAID()
+void OAIDService::WaitPersistOAIDTasks()
 {
-    std::string oaid = GainOAID();
-    std::string target = oaid.substr(0, 9).append(OAID_VIRTUAL_STR);
+    std::shared_ptr<AppExecFwk::EventHandler> handler;
+    {
+        std::lock_guard<std::mutex> lock(persistHandlerMutex_);
+        handler = persistHandler_;
+    }
+    if (handler == nullptr) {
+        return;
+    }
+    // Tasks run in order on the persist runner, so an empty sync task returns once all pending writes are done.
+    handler->PostSyncTask([]() {});
+}
+
+OaidValue OAIDService::GetOAID(uint64_t &generation)
+{
+    // Load the generation first: a reply may pair a newer value with an older generation, never the reverse.
+    generation = oaidGeneration_.load(std::memory_order_acquire);
+    OaidValue oaid = GainOAID();
     OAID_HILOGI(OAID_MODULE_SERVICE, "getOaid success");
     return oaid;
 }
 
 int32_t OAIDService::ResetOAID()
 {
-    std::string resetOaid = GetUUID();
-    // GetUUID的RAND_bytes可能为空，新增判空保护
-    if (resetOaid.empty()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "ResetOAID GetUUID failed!");
+    OaidValue resetOaid;
+    // RAND_bytes可能失败，新增判空保护
+    if (!OaidUuidGenerator::GetInstance().Generate(resetOaid)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "ResetOAID generate uuid failed!");
         return ERR_SYSYTEM_ERROR;
     }
     {
+        // Publish and enqueue under the same lock so the persisted order always matches the published order.
         std::lock_guard<std::mutex> autoLock(updateMutex_);
-        oaid_ = resetOaid;
+        PublishOAID(resetOaid);
+        PostPersistOAIDTask(resetOaid);
     }
-    bool result = WriteValueToKvStore(OAID_KVSTORE_KEY, resetOaid);
-    OAID_HILOGI(OAID_MODULE_SERVICE, "ResetOAID WriteValueToKvStore %{public}s", result == true ? "success" : "failed");
     ConnectAdsManager::GetInstance()->notifyKit(NOTIFY_RESET_OAID_CODE);
-    std::string target = resetOaid.substr(0, 9).append(OAID_VIRTUAL_STR);
-    OAID_HILOGI(OAID_MODULE_SERVICE, "resetOaid success oaid is: %{public}s", target.c_str());
+    OaidValue::FormatBuffer masked;
+    resetOaid.FormatMasked(masked);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "resetOaid success oaid is: %{public}s", masked.data());
+    NotifyOaidChanged();
     // 调用单例对象的oberser->OnUpdateOaid
     DelayedSingleton<OaidObserverManager>::GetInstance()->OnUpdateOaid(resetOaid);
     return ERR_OK;
 }
 
+void OAIDService::NotifyOaidChanged()
+{
+    uint64_t generation = oaidGeneration_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    DelayedSingleton<OaidObserverManager>::GetInstance()->NotifyResetListeners(generation);
+}
+
 bool OAIDService::SetAncoSwitchStatus(int32_t userId, const std::string& bundleName,
     const std::string& uid, int32_t status)
 {
@@ -311,19 +437,45 @@ bool OAIDService::SetAncoSwitchStatus(int32_t userId, const std::string& bundleN
     return (ret == ERR_OK);
 }
 
+bool OAIDService::SetAncoSwitchStatusBatch(const std::vector<AncoSwitchStatusInfo>& infos)
+{
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Service SetAncoSwitchStatusBatch called, count=%{public}zu", infos.size());
+    for (const auto& info : infos) {
+        if (info.userId < 0 || info.bundleName.empty() || info.uid.empty() ||
+            (info.status != SWITCH_ON && info.status != SWITCH_OFF)) {
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid switch status row, reject the whole batch");
+            return false;
+        }
+    }
+
+    int32_t ret = OaidRdbManager::GetInstance().Init();
+    if (ret != ERR_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to init RDB, ret=%{public}d", ret);
+        return false;
+    }
+
+    ret = OaidRdbManager::GetInstance().InsertOrReplaceSwitchStatusBatch(infos);
+    return (ret == ERR_OK);
+}
+
 std::vector<AncoSwitchStatusInfo> OAIDService::GetAncoSwitchStatus(int32_t userId,
     const std::string& bundleName, const std::string& uid)
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "GetAncoSwitchStatus called");
 
+    // The broker asks for one app on every access, answer it from memory without touching the RDB.
+    std::vector<AncoSwitchStatusInfo> result;
+    if (!bundleName.empty() && !uid.empty() &&
+        OaidRdbManager::GetInstance().QueryCachedSwitchStatus(userId, bundleName, uid, result)) {
+        return result;
+    }
+
     int32_t ret = OaidRdbManager::GetInstance().Init();
     if (ret != ERR_OK) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to init RDB, ret=%{public}d", ret);
         return {};
     }
 
-    OaidRdbManager::GetInstance().CleanUninstalledAppRecords(userId);
-
     return OaidRdbManager::GetInstance().QuerySwitchStatus(userId, bundleName, uid);
 }
 
@@ -338,24 +490,36 @@ std::vector<AncoAccessRecordInfo> OAIDService::GetAncoAccessRecords(int32_t user
         return {};
     }
 
-    OaidRdbManager::GetInstance().CleanUninstalledAppRecords(userId);
+    return OaidRdbManager::GetInstance().QueryAccessRecords(userId, bundleName, uid);
+}
 
-    std::async(std::launch::async, [userId]() {
-        OaidRdbManager::GetInstance().CleanExpiredAccessRecords(userId);
-    });
+int32_t OAIDService::GetAncoAccessRecordsPage(int32_t userId, const std::string& bundleName,
+    const std::string& uid, const std::string& cursor, int32_t pageSize, AncoAccessRecordPage& page)
+{
+    OAID_HILOGI(OAID_MODULE_SERVICE, "GetAncoAccessRecordsPage called");
+    if (userId < 0 || pageSize <= 0 || bundleName.empty() != uid.empty()) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Invalid parameter: userId/pageSize/bundleName/uid invalid");
+        return ERR_INVALID_PARAM;
+    }
 
-    return OaidRdbManager::GetInstance().QueryAccessRecords(userId, bundleName, uid);
+    int32_t ret = OaidRdbManager::GetInstance().Init();
+    if (ret != ERR_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to init RDB, ret=%{public}d", ret);
+        return ret;
+    }
+
+    return OaidRdbManager::GetInstance().QueryAccessRecordsPage(userId, bundleName, uid, cursor,
+        std::min(pageSize, ANCO_ACCESS_RECORD_PAGE_MAX_SIZE), page);
 }
 
 std::string OAIDService::GetAncoOAID()
 {
-    OAID_HILOGI(OAID_MODULE_SERVICE, "oaidKvStore_ status = %{public}d, oaidKvStoreExist = %{public}d",
-        oaidKvStore_ != nullptr, oaidKvStoreExist.load());
+    OAID_HILOGI(OAID_MODULE_SERVICE, "oaidKvStoreExist = %{public}d", oaidKvStoreExist.load());
     if (!oaidKvStoreExist) {
         OAID_HILOGW(OAID_MODULE_SERVICE, "kv no ready");
         return "";
     }
-    return GetOAID();
+    return GetOAID().ToString();
 }
 
 int32_t OAIDService::InsertAccessRecord(const int32_t userId, const std::string bundleName, const std::string uid)
@@ -384,103 +548,157 @@ DistributedKv::Options getOptions()
 
 bool OAIDService::InitKvStore(std::string storeIdStr)
 {
-    static std::mutex initMutex;
-    std::lock_guard<std::mutex> lock(initMutex);
-    if ((storeIdStr == OAID_DATA_BASE_STORE_ID && oaidKvStore_ != nullptr) ||
-        (storeIdStr == OAID_UNDER_AGE_STORE_ID && oaidUnderAgeKvStore_ != nullptr)) {
-        return true;
-    }
+    return AcquireKvStore(storeIdStr) != nullptr;
+}
+
+DistributedKv::Status OAIDService::OpenKvStore(const std::string &storeId,
+    std::shared_ptr<DistributedKv::SingleKvStore> &kvStore)
+{
     DistributedKv::DistributedKvDataManager manager;
     DistributedKv::Options options = getOptions();
     DistributedKv::AppId appId;
     appId.appId = OAID_DATA_BASE_APP_ID;
-    DistributedKv::StoreId storeId;
-    storeId.storeId = storeIdStr;
-    DistributedKv::Status status = DistributedKv::Status::SUCCESS;
-    std::shared_ptr<DistributedKv::SingleKvStore> kvStore_;
-    if (kvStore_ == nullptr) {
-        uint32_t retries = 0;
-        do {
-            status = manager.GetSingleKvStore(options, appId, storeId, kvStore_);
-            if (status == DistributedKv::Status::STORE_NOT_FOUND) {
-                OAID_HILOGE(OAID_MODULE_SERVICE, "InitOaidKvStore: STORE_NOT_FOUND!");
-            }
-            if ((status == DistributedKv::Status::SUCCESS) || (status == DistributedKv::Status::STORE_NOT_FOUND)) {
-                break;
-            } else {
-                OAID_HILOGE(OAID_MODULE_SERVICE, "Kvstore Connect failed! Retrying.retries=%{public}u", retries);
-                retries++;
-                usleep(KVSTORE_CONNECT_RETRY_DELAY_TIME);
-            }
-        } while (retries <= KVSTORE_CONNECT_RETRY_COUNT);
-    }
-    if (kvStore_ == nullptr) {
-        if (status == DistributedKv::Status::STORE_NOT_FOUND) {
-            OAID_HILOGI(OAID_MODULE_SERVICE, "First Boot: Create OaidKvStore");
-            options.createIfMissing = true;
-            status = manager.GetSingleKvStore(options, appId, storeId, kvStore_);
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Create OaidKvStore res = %{public}d", status);
-        }
+    DistributedKv::StoreId kvStoreId;
+    kvStoreId.storeId = storeId;
+    DistributedKv::Status status = manager.GetSingleKvStore(options, appId, kvStoreId, kvStore);
+    if (kvStore == nullptr && status == DistributedKv::Status::STORE_NOT_FOUND) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "First Boot: Create %{public}s", storeId.c_str());
+        options.createIfMissing = true;
+        status = manager.GetSingleKvStore(options, appId, kvStoreId, kvStore);
+        OAID_HILOGI(OAID_MODULE_SERVICE, "Create %{public}s res = %{public}d", storeId.c_str(), status);
+    }
+    return status;
+}
+
+OAIDService::KvStoreSlot &OAIDService::GetKvStoreSlot(const std::string &storeId)
+{
+    return (storeId == OAID_UNDER_AGE_STORE_ID) ? underAgeKvStoreSlot_ : oaidKvStoreSlot_;
+}
+
+void OAIDService::PublishKvStoreLocked(const std::string &storeId,
+    const std::shared_ptr<DistributedKv::SingleKvStore> &kvStore)
+{
+    KvStoreSlot &slot = GetKvStoreSlot(storeId);
+    slot.store = kvStore;
+    slot.state = (kvStore != nullptr) ? KvStoreState::READY : KvStoreState::FAILED;
+    if (storeId == OAID_DATA_BASE_STORE_ID) {
+        oaidKvStoreExist = (kvStore != nullptr);
     }
-    if (kvStore_ == nullptr) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "InitOaidKvStore: Failed!");
-        return false;
+    kvStoreCond_.notify_all();
+}
+
+void OAIDService::StartKvStoreWarmUp()
+{
+    std::lock_guard<std::mutex> lock(kvStoreMutex_);
+    kvWarmUpStopping_ = false;
+    for (const std::string &storeId : {OAID_DATA_BASE_STORE_ID, OAID_UNDER_AGE_STORE_ID}) {
+        KvStoreSlot &slot = GetKvStoreSlot(storeId);
+        if (slot.state == KvStoreState::READY || slot.state == KvStoreState::OPENING) {
+            continue;
+        }
+        slot.state = KvStoreState::OPENING;
+        kvWarmUpThreads_.emplace_back(&OAIDService::WarmUpKvStore, storeId);
     }
-    if (storeIdStr == OAID_DATA_BASE_STORE_ID) {
-        oaidKvStore_ = kvStore_;
-    } else if (storeIdStr == OAID_UNDER_AGE_STORE_ID) {
-        oaidUnderAgeKvStore_ = kvStore_;
+}
+
+void OAIDService::StopKvStoreWarmUp()
+{
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(kvStoreMutex_);
+        kvWarmUpStopping_ = true;
+        threads.swap(kvWarmUpThreads_);
+    }
+    kvStoreCond_.notify_all();
+    for (auto &thread : threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
     }
-    return true;
 }
 
-bool OAIDService::CheckUnderAgeKvStore()
+void OAIDService::WarmUpKvStore(const std::string &storeId)
 {
-    if (oaidUnderAgeKvStore_ != nullptr) {
-        return true;
+    int64_t beginTimeMs = GetSteadyTimeMs();
+    uint32_t backoffMs = KVSTORE_WARM_UP_INITIAL_BACKOFF_MS;
+    std::shared_ptr<DistributedKv::SingleKvStore> kvStore;
+    for (uint32_t retries = 0;; retries++) {
+        DistributedKv::Status status = OpenKvStore(storeId, kvStore);
+        if (kvStore != nullptr || retries >= KVSTORE_CONNECT_RETRY_COUNT) {
+            break;
+        }
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Kvstore %{public}s connect failed, status=%{public}d, retry in %{public}u ms",
+            storeId.c_str(), status, backoffMs);
+        std::unique_lock<std::mutex> lock(kvStoreMutex_);
+        if (kvStoreCond_.wait_for(lock, milliseconds(backoffMs), []() { return kvWarmUpStopping_; })) {
+            break;
+        }
+        backoffMs = std::min(backoffMs * 2, KVSTORE_WARM_UP_MAX_BACKOFF_MS);
     }
-    bool result = InitKvStore(OAID_UNDER_AGE_STORE_ID);
-    OAID_HILOGI(OAID_MODULE_SERVICE, "InitUnderAgeKvStore: %{public}s", result == true ? "success" : "failed");
-    return result;
+
+    std::lock_guard<std::mutex> lock(kvStoreMutex_);
+    PublishKvStoreLocked(storeId, kvStore);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Warm up %{public}s %{public}s in %{public}" PRId64 " ms", storeId.c_str(),
+        kvStore != nullptr ? "success" : "failed", GetSteadyTimeMs() - beginTimeMs);
 }
 
-bool OAIDService::ReadValueFromUnderAgeKvStore(const std::string &kvStoreKey, DistributedKv::Value &kvStoreValue)
+std::shared_ptr<DistributedKv::SingleKvStore> OAIDService::AcquireKvStore(const std::string &storeId)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!CheckUnderAgeKvStore()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "ReadValueFromUnderAgeKvStore:oaidUnderAgeKvStore_ is nullptr");
-        return false;
+    std::unique_lock<std::mutex> lock(kvStoreMutex_);
+    KvStoreSlot &slot = GetKvStoreSlot(storeId);
+    if (slot.state == KvStoreState::OPENING) {
+        // Wait for the warm-up instead of retrying on a binder thread.
+        bool settled = kvStoreCond_.wait_for(lock, milliseconds(KVSTORE_READY_WAIT_TIMEOUT_MS),
+            [&slot]() { return slot.state != KvStoreState::OPENING; });
+        if (!settled) {
+            OAID_HILOGW(OAID_MODULE_SERVICE, "%{public}s not ready in %{public}" PRId64 " ms", storeId.c_str(),
+                KVSTORE_READY_WAIT_TIMEOUT_MS);
+            return nullptr;
+        }
     }
-    DistributedKv::Key key(kvStoreKey);
-    DistributedKv::Status status = oaidUnderAgeKvStore_->Get(key, kvStoreValue);
-    if (status == DistributedKv::Status::SUCCESS) {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "%{public}d get value from kvStore", status);
-    } else {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "%{public}d get value from kvStore failed", status);
-        return false;
+    if (slot.state == KvStoreState::READY) {
+        return slot.store;
     }
-    return true;
+
+    // No warm-up running (never started or gave up): make a single attempt, without holding the lock.
+    slot.state = KvStoreState::OPENING;
+    lock.unlock();
+    std::shared_ptr<DistributedKv::SingleKvStore> kvStore;
+    DistributedKv::Status status = OpenKvStore(storeId, kvStore);
+    OAID_HILOGI(OAID_MODULE_SERVICE, "Open %{public}s on demand, status=%{public}d", storeId.c_str(), status);
+    lock.lock();
+    PublishKvStoreLocked(storeId, kvStore);
+    return kvStore;
 }
 
-bool OAIDService::WriteValueToUnderAgeKvStore(const std::string &kvStoreKey, const DistributedKv::Value &kvStoreValue)
+OaidStateStoreStatus OAIDService::ReadValueFromUnderAgeKvStore(const std::string &kvStoreKey,
+    DistributedKv::Value &kvStoreValue)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!CheckUnderAgeKvStore()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "WriteValueToUnderAgeKvStore:oaidKvStore_ is nullptr");
-        return false;
-    }
+    std::vector<uint8_t> value;
+    OaidStateStoreStatus status = GetStateStore(OAID_UNDER_AGE_STORE_ID)->Get(kvStoreKey, value);
+    if (status != OaidStateStoreStatus::SUCCESS) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "ReadValueFromUnderAgeKvStore failed, status=%{public}d",
+            static_cast<int32_t>(status));
+        return status;
+    }
+    kvStoreValue = DistributedKv::Value(value);
+    return status;
+}
 
-    DistributedKv::Key key(kvStoreKey);
-    DistributedKv::Status status = oaidUnderAgeKvStore_->Put(key, kvStoreValue);
-    if (status == DistributedKv::Status::SUCCESS) {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "%{public}d updated to kvStore", status);
-    } else {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "%{public}d update to kvStore failed", status);
+bool OAIDService::WriteValueToUnderAgeKvStore(const std::string &kvStoreKey, const DistributedKv::Value &kvStoreValue)
+{
+    if (!GetStateStore(OAID_UNDER_AGE_STORE_ID)->Put(kvStoreKey, kvStoreValue.Data())) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "WriteValueToUnderAgeKvStore failed");
         return false;
     }
     return true;
 }
 
+bool OAIDService::DeleteValueFromUnderAgeKvStore(const std::string &kvStoreKey)
+{
+    return GetStateStore(OAID_UNDER_AGE_STORE_ID)->Delete(kvStoreKey);
+}
+
 std::string Str16ToStr8(const std::u16string &str)
 {
     std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
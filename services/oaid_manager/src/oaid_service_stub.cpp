@@ -14,21 +14,24 @@
  */
 
 #include "oaid_service_stub.h"
+#include <chrono>
+#include <cinttypes>
 #include <singleton.h>
 #include "bundle_mgr_helper.h"
 #include "bundle_mgr_client.h"
 #include "accesstoken_kit.h"
-#include "privacy_kit.h"
 #include "tokenid_kit.h"
 #include "oaid_common.h"
 #include "oaid_service_define.h"
 #include "oaid_service.h"
 #include "oaid_service_ipc_interface_code.h"
-#include "config_policy_utils.h"
 #include "iservice_registry.h"
+#include "oaid_config_manager.h"
 #include "oaid_remote_config_observer_stub.h"
 #include "oaid_remote_config_observer_proxy.h"
+#include "oaid_reset_listener_proxy.h"
 #include "oaid_observer_manager.h"
+#include "oaid_permission_usage_reporter.h"
 #include "connect_ads_stub.h"
 #include "atm_utils.h"
 #include "ipc_serialization_transporter.h"
@@ -41,6 +44,12 @@ using namespace OHOS::HiviewDFX;
 namespace {
     const std::string SECURITY_PRIVACY_CENTER_BUNDLENAME = "com.huawei.hmos.security.privacycenter";
     static const pid_t VALID_UID = 5557;
+
+    int64_t GetSteadyTimeMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
 }
 OAIDServiceStub::OAIDServiceStub()
 {}
@@ -69,13 +78,9 @@ bool OAIDServiceStub::CheckPermission(const std::string &permissionName)
     }
 
     if (callingType == TOKEN_HAP) {
-        int32_t successCnt = (int32_t)(result == TypePermissionState::PERMISSION_GRANTED);
-        int32_t failCnt = 1 - successCnt;  // 1 means that there is only one visit in total
-        // AddPermissionUsedRecord needs to transfer both the number of successful and failed permission access requests
-        int32_t ret = PrivacyKit::AddPermissionUsedRecord(callingToken, permissionName, successCnt, failCnt);
-        if (ret != 0) {
-            OAID_HILOGI(OAID_MODULE_SERVICE, "AddPermissionUsedRecord ret=%{public}d", ret);
-        }
+        // Usage is aggregated and reported to the privacy service off the binder thread.
+        OaidPermissionUsageReporter::GetInstance().Report(
+            callingToken, permissionName, result == TypePermissionState::PERMISSION_GRANTED);
     }
 
     if (result == TypePermissionState::PERMISSION_DENIED) {
@@ -122,118 +127,112 @@ bool OAIDServiceStub::CheckBrokerSA()
     return VALID_UID == callingUid;
 }
 
-bool LoadAndCheckOaidTrustList(const std::string &bundleName)
+const std::string &OAIDServiceStub::CallerInfo::GetBundleName()
 {
-    char pathBuff[PATH_MAX] = {0};
-    GetOneCfgFile(OAID_TRUSTLIST_EXTENSION_CONFIG_PATH.c_str(), pathBuff, PATH_MAX);
-    char realPath[PATH_MAX] = {0};
-    if (realpath(pathBuff, realPath) == nullptr) {
-        GetOneCfgFile(OAID_TRUSTLIST_CONFIG_PATH.c_str(), pathBuff, PATH_MAX);
-        if (realpath(pathBuff, realPath) == nullptr) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Parse realpath fail");
-            return false;
-        }
-    }
-    std::ifstream inFile(realPath, std::ios::in);
-    if (!inFile.is_open()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Open file error.");
-        return false;
+    if (bundleNameResolved_) {
+        return bundleName_;
     }
-    std::string fileContent((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
-    cJSON *root = cJSON_Parse(fileContent.c_str());
-    inFile.close();
-    if (root == nullptr) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "ParseJsonFromFile is not in JSON format.");
-        return false;
+    bundleNameResolved_ = true;
+    if ((attrs_ & CALLER_ATTR_BUNDLE_NAME) == 0) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "bundle name is not declared for this code");
+        return bundleName_;
     }
-    cJSON *oaidTrustConfig = cJSON_GetObjectItem(root, "resetOAIDBundleName");
-    if (oaidTrustConfig == nullptr || !cJSON_IsArray(oaidTrustConfig)) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "not contain resetOAIDBundleName node.");
-        cJSON_Delete(root);
-        return false;
-    }
-    int arraySize = cJSON_GetArraySize(oaidTrustConfig);
-    if (arraySize == 0) {
-        OAID_HILOGI(OAID_MODULE_SERVICE, "oaidTrustConfig list is empty.");
-        cJSON_Delete(root);
-        return true;
-    }
-    for (int i = 0; i < arraySize; i++) {
-        cJSON *item = cJSON_GetArrayItem(oaidTrustConfig, i);
-        if (cJSON_IsString(item)) {
-            if (bundleName.compare(item->valuestring) == 0) {
-                OAID_HILOGI(OAID_MODULE_SERVICE, "the oaidWhiteList contains this bundle name");
-                cJSON_Delete(root);
-                return true;
-            }
-        }
+    DelayedSingleton<BundleMgrHelper>::GetInstance()->GetBundleNameByUid(static_cast<int>(uid_), bundleName_);
+    return bundleName_;
+}
+
+const OAIDServiceStub::CodeEntry *OAIDServiceStub::FindCodeEntry(uint32_t code)
+{
+    static constexpr CodeEntry CODE_TABLE[] = {
+        {static_cast<uint32_t>(OAIDInterfaceCode::GET_OAID), &OAIDServiceStub::OnGetOAID,
+            CallerPolicy::APP_TRACKING_PERMISSION, CALLER_ATTR_BUNDLE_NAME},
+        {static_cast<uint32_t>(OAIDInterfaceCode::RESET_OAID), &OAIDServiceStub::OnResetOAID,
+            CallerPolicy::RESET_TRUST_LIST, CALLER_ATTR_BUNDLE_NAME},
+        {static_cast<uint32_t>(OAIDInterfaceCode::REGISTER_CONTROL_CONFIG_OBSERVER),
+            &OAIDServiceStub::HandleRegisterControlConfigObserver, CallerPolicy::HA_UID, CALLER_ATTR_NONE},
+        {static_cast<uint32_t>(OAIDInterfaceCode::SET_ANCO_SWITCH_STATUS), &OAIDServiceStub::OnSetAncoSwitchStatus,
+            CallerPolicy::PRIVACY_HAP_OR_BROKER, CALLER_ATTR_NONE},
+        {static_cast<uint32_t>(OAIDInterfaceCode::GET_ANCO_SWITCH_STATUS), &OAIDServiceStub::OnGetAncoSwitchStatus,
+            CallerPolicy::PRIVACY_HAP_OR_BROKER, CALLER_ATTR_NONE},
+        {static_cast<uint32_t>(OAIDInterfaceCode::GET_ANCO_ACCESS_RECORDS),
+            &OAIDServiceStub::OnGetAncoAccessRecords, CallerPolicy::PRIVACY_HAP, CALLER_ATTR_NONE},
+        {static_cast<uint32_t>(OAIDInterfaceCode::GET_ANCO_OAID), &OAIDServiceStub::OnGetAncoOAID,
+            CallerPolicy::BROKER_SA, CALLER_ATTR_NONE},
+        {static_cast<uint32_t>(OAIDInterfaceCode::SET_ANCO_ACCESS_RECORDS), &OAIDServiceStub::OnInsertAccessRecord,
+            CallerPolicy::BROKER_SA, CALLER_ATTR_NONE},
+        {static_cast<uint32_t>(OAIDInterfaceCode::REGISTER_RESET_LISTENER),
+            &OAIDServiceStub::HandleRegisterResetListener, CallerPolicy::APP_TRACKING_PERMISSION, CALLER_ATTR_NONE},
+        {static_cast<uint32_t>(OAIDInterfaceCode::GET_ANCO_ACCESS_RECORDS_PAGE),
+            &OAIDServiceStub::OnGetAncoAccessRecordsPage, CallerPolicy::PRIVACY_HAP, CALLER_ATTR_NONE},
+        {static_cast<uint32_t>(OAIDInterfaceCode::SET_ANCO_SWITCH_STATUS_BATCH),
+            &OAIDServiceStub::OnSetAncoSwitchStatusBatch, CallerPolicy::PRIVACY_HAP_OR_BROKER, CALLER_ATTR_NONE},
+    };
+    constexpr size_t tableSize = sizeof(CODE_TABLE) / sizeof(CODE_TABLE[0]);
+    // 表按接口码顺序排列，直接下标寻址
+    if (code >= tableSize || CODE_TABLE[code].code != code) {
+        return nullptr;
     }
-    cJSON_Delete(root);
-    return false;
+    return &CODE_TABLE[code];
 }
 
-int32_t OAIDServiceStub::SendCode(uint32_t code, MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::CheckCallerPolicy(const CodeEntry &entry, CallerInfo &caller, MessageParcel &reply)
 {
-    switch (code) {
-        case static_cast<uint32_t>(OAIDInterfaceCode::GET_OAID): {
-            return OAIDServiceStub::OnGetOAID(data, reply);
-            break;
-        }
-        case static_cast<uint32_t>(OAIDInterfaceCode::RESET_OAID): {
-            return OAIDServiceStub::OnResetOAID(data, reply);
-            break;
-        }
-        case static_cast<uint32_t>(OAIDInterfaceCode::REGISTER_CONTROL_CONFIG_OBSERVER): {
-            return OAIDServiceStub::HandleRegisterControlConfigObserver(data, reply);
-            break;
-        }
-        case static_cast<uint32_t>(OAIDInterfaceCode::SET_ANCO_SWITCH_STATUS): {
-            return OAIDServiceStub::OnSetAncoSwitchStatus(data, reply);
-            break;
-        }
-        case static_cast<uint32_t>(OAIDInterfaceCode::GET_ANCO_SWITCH_STATUS): {
-            return OAIDServiceStub::OnGetAncoSwitchStatus(data, reply);
-            break;
-        }
-        case static_cast<uint32_t>(OAIDInterfaceCode::GET_ANCO_ACCESS_RECORDS): {
-            return OAIDServiceStub::OnGetAncoAccessRecords(data, reply);
-            break;
-        }
-        case static_cast<uint32_t>(OAIDInterfaceCode::GET_ANCO_OAID): {
-            return OAIDServiceStub::OnGetAncoOAID(data, reply);
-            break;
-        }
-        case static_cast<uint32_t>(OAIDInterfaceCode::SET_ANCO_ACCESS_RECORDS): {
-            return OAIDServiceStub::OnInsertAccessRecord(data, reply);
-            break;
-        }
+    switch (entry.policy) {
+        case CallerPolicy::APP_TRACKING_PERMISSION:
+            if (!CheckPermission(OAID_TRACKING_CONSENT_PERMISSION)) {
+                OAID_HILOGW(OAID_MODULE_SERVICE, "bundleName %{public}s not granted the app tracking permission",
+                    caller.GetBundleName().c_str());
+                return ERR_PERMISSION_ERROR;
+            }
+            return ERR_OK;
+        case CallerPolicy::RESET_TRUST_LIST:
+            return ValidateResetOAIDPermission(caller.GetBundleName(), reply);
+        case CallerPolicy::HA_UID:
+            if (caller.GetUid() != HA_UID) {
+                OAID_HILOGE(OAID_MODULE_SERVICE, "callingUid error, error code is: %{public}d", ERR_INVALID_PARAM);
+                return ERR_INVALID_PARAM;
+            }
+            return ERR_OK;
+        case CallerPolicy::PRIVACY_HAP_OR_BROKER:
+            if (!CheckSecurityPrivacyHap() && !CheckBrokerSA()) {
+                OAID_HILOGE(OAID_MODULE_SERVICE, "check security privacy center hap or Check broker sa failed");
+                return ERR_PERMISSION_ERROR;
+            }
+            return ERR_OK;
+        case CallerPolicy::PRIVACY_HAP:
+            if (!CheckSecurityPrivacyHap()) {
+                OAID_HILOGE(OAID_MODULE_SERVICE, "check security privacy center hap failed");
+                return ERR_PERMISSION_ERROR;
+            }
+            return ERR_OK;
+        case CallerPolicy::BROKER_SA:
+            if (!CheckBrokerSA()) {
+                OAID_HILOGE(OAID_MODULE_SERVICE, "Check broker sa failed");
+                return ERR_PERMISSION_ERROR;
+            }
+            return ERR_OK;
     }
-    return ERR_SYSYTEM_ERROR;
+    return ERR_PERMISSION_ERROR;
 }
 
 int32_t OAIDServiceStub::OnRemoteRequest(
     uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option)
 {
-    ExitIdleState();
-    PostDelayUnloadTask();
+    RecordActivity();
     OAID_HILOGI(OAID_MODULE_SERVICE, "Start, code is %{public}u.", code);
-    std::string bundleName;
-    pid_t uid = IPCSkeleton::GetCallingUid();
-    DelayedSingleton<BundleMgrHelper>::GetInstance()->GetBundleNameByUid(static_cast<int>(uid), bundleName);
-    if (code == static_cast<uint32_t>(OAIDInterfaceCode::GET_OAID) &&
-        !CheckPermission(OAID_TRACKING_CONSENT_PERMISSION)) {
-        OAID_HILOGW(
-            OAID_MODULE_SERVICE, "bundleName %{public}s not granted the app tracking permission", bundleName.c_str());
+    const CodeEntry *entry = FindCodeEntry(code);
+    if (entry == nullptr) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "unknown code %{public}u.", code);
+        return ERR_SYSYTEM_ERROR;
+    }
+    CallerInfo caller(IPCSkeleton::GetCallingUid(), entry->attrs);
+    int32_t policyResult = CheckCallerPolicy(*entry, caller, reply);
+    if (policyResult == ERR_PERMISSION_ERROR && (entry->policy == CallerPolicy::APP_TRACKING_PERMISSION ||
+        entry->policy == CallerPolicy::RESET_TRUST_LIST)) {
         return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
     }
-    if (code == static_cast<uint32_t>(OAIDInterfaceCode::RESET_OAID)) {
-        int32_t validateResult = ValidateResetOAIDPermission(bundleName, reply);
-        if (validateResult == ERR_SYSYTEM_ERROR) {
-            return ERR_SYSYTEM_ERROR;
-        }
-        if (validateResult == ERR_PERMISSION_ERROR) {
-            return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
-        }
+    if (policyResult != ERR_OK) {
+        return policyResult;
     }
     std::u16string myDescripter = OAIDServiceStub::GetDescriptor();
     std::u16string remoteDescripter = data.ReadInterfaceToken();
@@ -241,12 +240,12 @@ int32_t OAIDServiceStub::OnRemoteRequest(
         OAID_HILOGE(OAID_MODULE_SERVICE, "Descriptor checked fail.");
         return ERR_SYSYTEM_ERROR;
     }
-    return SendCode(code, data, reply);
+    return (this->*(entry->handler))(data, reply, caller);
 }
 
-int32_t OAIDServiceStub::ValidateResetOAIDPermission(std::string bundleName, MessageParcel &reply)
+int32_t OAIDServiceStub::ValidateResetOAIDPermission(const std::string &bundleName, MessageParcel &reply)
 {
-    if (!LoadAndCheckOaidTrustList(bundleName)) {
+    if (!OaidConfigManager::GetInstance().IsInResetTrustList(bundleName)) {
         OAID_HILOGW(
             OAID_MODULE_SERVICE, "CheckOaidTrustList fail.errorCode = %{public}d", OAID_ERROR_NOT_IN_TRUST_LIST);
         if (!reply.WriteInt32(OAID_ERROR_NOT_IN_TRUST_LIST)) {
@@ -267,64 +266,35 @@ int32_t OAIDServiceStub::ValidateResetOAIDPermission(std::string bundleName, Mes
     return ERR_OK;
 }
 
-int32_t OAIDServiceStub::OnGetOAID(MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::OnGetOAID(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
 {
-    auto oaid = GetOAID();
-    if (oaid == "") {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Get OAID failed.");
-        return ERR_SYSYTEM_ERROR;
-    }
-
-    if (!reply.WriteString(oaid)) {
+    uint64_t generation = 0;
+    OaidValue oaid = GetOAID(generation);
+    if (!oaid.WriteToParcel(reply) || !reply.WriteUint64(generation)) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to write parcelable.");
         return ERR_SYSYTEM_ERROR;
     }
-    checkProviderBundleName();
+    checkProviderBundleName(caller);
     return ERR_OK;
 }
 
-void OAIDServiceStub::checkProviderBundleName()
+void OAIDServiceStub::checkProviderBundleName(CallerInfo &caller)
 {
-    char pathBuff[PATH_MAX] = {0};
-    GetOneCfgFile(OAID_TRUSTLIST_EXTENSION_CONFIG_PATH.c_str(), pathBuff, PATH_MAX);
-    char realPath[PATH_MAX] = {0};
-    if (realpath(pathBuff, realPath) == nullptr) {
-        GetOneCfgFile(OAID_TRUSTLIST_CONFIG_PATH.c_str(), pathBuff, PATH_MAX);
-        if (realpath(pathBuff, realPath) == nullptr) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Parse realpath fail");
-            return;
-        }
-    }
-    std::ifstream inFile(realPath, std::ios::in);
-    if (!inFile.is_open()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Open file error.");
+    auto config = OaidConfigManager::GetInstance().GetConfig();
+    if (config == nullptr) {
         return;
     }
-    std::string fileContent((std::istreambuf_iterator<char>{inFile}), std::istreambuf_iterator<char>{});
-    cJSON *root = cJSON_Parse(fileContent.c_str());
-    inFile.close();
-    if (root == nullptr) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "ParseJsonFromFile is not in JSON format.");
-        return;
-    }
-    cJSON *oaidProviderBundleNameConfig = cJSON_GetObjectItem(root, "providerBundleName");
-    if (oaidProviderBundleNameConfig == nullptr || oaidProviderBundleNameConfig->type != cJSON_String) {
+    if (!config->providerBundleName.has_value()) {
         OAID_HILOGE(OAID_MODULE_SERVICE, "not contain providerBundleName node.");
-        cJSON_Delete(root);
         return;
     }
-    std::string bundleName;
-    const char *providerBundleName = oaidProviderBundleNameConfig->valuestring;
-    pid_t uid = IPCSkeleton::GetCallingUid();
-    DelayedSingleton<BundleMgrHelper>::GetInstance()->GetBundleNameByUid(static_cast<int>(uid), bundleName);
-    if (bundleName.compare(providerBundleName) == 0) {
+    if (caller.GetBundleName() == config->providerBundleName.value()) {
         ConnectAdsManager::GetInstance()->notifyKit(NOTIFY_GET_OAID_CODE);
     }
-    cJSON_Delete(root);
     OAID_HILOGI(OAID_MODULE_SERVICE, "end checkProviderBundleName ");
 }
 
-int32_t OAIDServiceStub::OnResetOAID(MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::OnResetOAID(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "Reset OAID Start.");
 
@@ -351,41 +321,71 @@ void OAIDServiceStub::ExitIdleState()
     }
 }
 
-void OAIDServiceStub::PostDelayUnloadTask()
+void OAIDServiceStub::RecordActivity()
+{
+    lastActivityTime_.store(GetSteadyTimeMs(), std::memory_order_release);
+    // samgr only needs to hear from us when an unload has actually been requested.
+    if (unloadRequested_.exchange(false, std::memory_order_acq_rel)) {
+        ExitIdleState();
+    } else {
+        samgrCallsSaved_.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (!idleTimerArmed_.exchange(true, std::memory_order_acq_rel)) {
+        ArmIdleTimer(DELAY_TIME);
+    }
+}
+
+void OAIDServiceStub::ArmIdleTimer(int64_t delayMs)
 {
-    init_eventHandler_Mutex_.lock();
-    if (unloadHandler_ == nullptr) {
-        const char *runnerName = "unlock";
-        auto runner = AppExecFwk::EventRunner::Create(runnerName);
+    std::call_once(unloadHandlerOnce_, [this]() {
+        auto runner = AppExecFwk::EventRunner::Create("unlock");
         unloadHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    });
+    if (unloadHandler_ == nullptr || !unloadHandler_->PostTask([this]() { CheckIdle(); }, TASK_ID, delayMs)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "post idle check task failed.");
+        idleTimerArmed_.store(false, std::memory_order_release);
     }
-    init_eventHandler_Mutex_.unlock();
-    auto task = [this]() {
-        auto samgrProxy = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
-        if (samgrProxy == nullptr) {
-            OAID_HILOGE(OAID_MODULE_SERVICE, "Get samgr failed.");
-            return;
+}
+
+void OAIDServiceStub::CheckIdle()
+{
+    int64_t lastActivityTime = lastActivityTime_.load(std::memory_order_acquire);
+    int64_t idleTime = GetSteadyTimeMs() - lastActivityTime;
+    if (idleTime < DELAY_TIME) {
+        ArmIdleTimer(DELAY_TIME - idleTime);
+        return;
+    }
+
+    idleTimerArmed_.store(false, std::memory_order_release);
+    unloadRequested_.store(true, std::memory_order_release);
+    // A request slipped in while going idle, it now owns re-arming the timer or we take it back.
+    if (lastActivityTime_.load(std::memory_order_acquire) != lastActivityTime) {
+        if (unloadRequested_.exchange(false, std::memory_order_acq_rel) &&
+            !idleTimerArmed_.exchange(true, std::memory_order_acq_rel)) {
+            ArmIdleTimer(DELAY_TIME);
         }
-        int32_t ret = samgrProxy->UnloadSystemAbility(OAID_SYSTME_ID);
-        if (ret != ERR_OK) {
-            OAID_HILOGE(OAID_MODULE_SERVICE,
-                "Unload system ability %{public}d failed, result: %{public}d.",
-                OAID_SYSTME_ID,
-                ret);
-            return;
+        return;
+    }
+
+    OAID_HILOGI(OAID_MODULE_SERVICE, "service idle, samgr calls saved: %{public}" PRIu64,
+        samgrCallsSaved_.load(std::memory_order_relaxed));
+    auto samgrProxy = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    int32_t ret = (samgrProxy == nullptr) ? ERR_SYSYTEM_ERROR : samgrProxy->UnloadSystemAbility(OAID_SYSTME_ID);
+    if (ret != ERR_OK) {
+        OAID_HILOGE(OAID_MODULE_SERVICE,
+            "Unload system ability %{public}d failed, result: %{public}d.",
+            OAID_SYSTME_ID,
+            ret);
+        // Stay loaded and retry after another idle period.
+        unloadRequested_.store(false, std::memory_order_release);
+        if (!idleTimerArmed_.exchange(true, std::memory_order_acq_rel)) {
+            ArmIdleTimer(DELAY_TIME);
         }
-    };
-    unloadHandler_->RemoveTask(TASK_ID);
-    unloadHandler_->PostTask(task, TASK_ID, DELAY_TIME);
+    }
 }
 
-int32_t OAIDServiceStub::HandleRegisterControlConfigObserver(MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::HandleRegisterControlConfigObserver(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
 {
-    int32_t uid = IPCSkeleton::GetCallingUid();
-    if (uid != HA_UID) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "callingUid error, error code is: %{public}d", ERR_INVALID_PARAM);
-        return ERR_INVALID_PARAM;
-    }
     auto remoteObject = data.ReadRemoteObject();
     if (!remoteObject) {
         OAID_HILOGI(OAID_MODULE_SERVICE, "Observer is null, error code is: %{public}d", ERR_NULL_POINTER);
@@ -399,18 +399,35 @@ int32_t OAIDServiceStub::HandleRegisterControlConfigObserver(MessageParcel &data
     return RegisterObserver(observer);
 }
 
+int32_t OAIDServiceStub::HandleRegisterResetListener(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
+{
+    auto remoteObject = data.ReadRemoteObject();
+    if (!remoteObject) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "Listener is null, error code is: %{public}d", ERR_NULL_POINTER);
+        return ERR_NULL_POINTER;
+    }
+    auto listener = iface_cast<IOaidResetListener>(remoteObject);
+    if (listener == nullptr) {
+        OAID_HILOGI(OAID_MODULE_SERVICE, "Listener is null, error code is: %{public}d", ERR_NULL_POINTER);
+        return ERR_NULL_POINTER;
+    }
+    return DelayedSingleton<OaidObserverManager>::GetInstance()->RegisterResetListener(listener, caller.GetUid());
+}
+
+int32_t OAIDServiceStub::RegisterResetListener(const sptr<IOaidResetListener> &listener)
+{
+    return DelayedSingleton<OaidObserverManager>::GetInstance()->RegisterResetListener(listener,
+        IPCSkeleton::GetCallingUid());
+}
+
 int32_t OAIDServiceStub::RegisterObserver(const sptr<IRemoteConfigObserver> &observer)
 {
     OAID_HILOGI(OAID_MODULE_SERVICE, "registerObserver success.");
     return DelayedSingleton<OaidObserverManager>::GetInstance()->RegisterObserver(observer);
 }
 
-int32_t OAIDServiceStub::OnSetAncoSwitchStatus(MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::OnSetAncoSwitchStatus(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
 {
-    if (!CheckSecurityPrivacyHap() && !CheckBrokerSA()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "check security privacy center hap or Check broker sa failed");
-        return ERR_PERMISSION_ERROR;
-    }
     int32_t userId = data.ReadInt32();
     std::string bundleName = data.ReadString();
     std::string uid = data.ReadString();
@@ -424,6 +441,30 @@ int32_t OAIDServiceStub::OnSetAncoSwitchStatus(MessageParcel &data, MessageParce
     return ERR_OK;
 }
 
+int32_t OAIDServiceStub::OnSetAncoSwitchStatusBatch(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
+{
+    uint32_t count = data.ReadUint32();
+    if (count == 0 || count > ANCO_SWITCH_STATUS_BATCH_MAX_SIZE) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "OnSetAncoSwitchStatusBatch invalid count=%{public}u", count);
+        return ERR_INVALID_PARAM;
+    }
+    std::vector<AncoSwitchStatusInfo> infos(count);
+    for (auto &info : infos) {
+        if (!data.ReadInt32(info.userId) || !data.ReadString(info.bundleName) || !data.ReadString(info.uid) ||
+            !data.ReadInt32(info.status)) {
+            OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to read switch status row");
+            return ERR_INVALID_PARAM;
+        }
+    }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "OnSetAncoSwitchStatusBatch called, count=%{public}u", count);
+    bool result = SetAncoSwitchStatusBatch(infos);
+    if (!reply.WriteBool(result)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "Failed to write result to reply");
+        return ERR_WRITE_PARCEL_FAILED;
+    }
+    return ERR_OK;
+}
+
 template <>
 bool IpcSerializationTransporter::Flat(const AncoSwitchStatusInfo& rawData)
 {
@@ -473,12 +514,8 @@ bool IpcSerializationTransporter::Flat(const AncoAccessRecordInfo& rawData)
     return true;
 }
 
-int32_t OAIDServiceStub::OnGetAncoSwitchStatus(MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::OnGetAncoSwitchStatus(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
 {
-    if (!CheckSecurityPrivacyHap() && !CheckBrokerSA()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "check security privacy center hap or Check broker sa failed");
-        return ERR_PERMISSION_ERROR;
-    }
     int32_t userId = data.ReadInt32();
     std::string bundleName = data.ReadString();
     std::string uid = data.ReadString();
@@ -503,12 +540,8 @@ int32_t OAIDServiceStub::OnGetAncoSwitchStatus(MessageParcel &data, MessageParce
     return ERR_OK;
 }
 
-int32_t OAIDServiceStub::OnGetAncoAccessRecords(MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::OnGetAncoAccessRecords(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
 {
-    if (!CheckSecurityPrivacyHap()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "check security privacy center hap failed");
-        return ERR_PERMISSION_ERROR;
-    }
     int32_t userId = data.ReadInt32();
     std::string bundleName = data.ReadString();
     std::string uid = data.ReadString();
@@ -533,12 +566,38 @@ int32_t OAIDServiceStub::OnGetAncoAccessRecords(MessageParcel &data, MessageParc
     return ERR_OK;
 }
 
-int32_t OAIDServiceStub::OnGetAncoOAID(MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::OnGetAncoAccessRecordsPage(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
 {
-    if (!CheckBrokerSA()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Check broker sa failed");
-        return ERR_PERMISSION_ERROR;
+    int32_t userId = data.ReadInt32();
+    std::string bundleName = data.ReadString();
+    std::string uid = data.ReadString();
+    std::string cursor = data.ReadString();
+    int32_t pageSize = data.ReadInt32();
+    OAID_HILOGI(OAID_MODULE_SERVICE, "OnGetAncoAccessRecordsPage called, pageSize=%{public}d", pageSize);
+    AncoAccessRecordPage page;
+    int32_t ret = GetAncoAccessRecordsPage(userId, bundleName, uid, cursor, pageSize, page);
+    if (ret != ERR_OK) {
+        return ret;
+    }
+    // A page is bounded by ANCO_ACCESS_RECORD_PAGE_MAX_SIZE, so the raw data stays small.
+    IpcSerializationTransporter transporter;
+    auto resultOpt = transporter.Serialize(page.records);
+    if (!resultOpt.has_value()) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "serialize ancoAccessRecordInfo failed. resultOpt is nullopt");
+        return ERR_WRITE_PARCEL_FAILED;
+    }
+    if (!reply.WriteUint64(resultOpt.value().size()) ||
+        !reply.WriteRawData(resultOpt.value().c_str(), resultOpt.value().size()) ||
+        !reply.WriteString(page.nextCursor)) {
+        OAID_HILOGE(OAID_MODULE_SERVICE, "write ancoAccessRecordPage failed");
+        return ERR_WRITE_PARCEL_FAILED;
     }
+    OAID_HILOGI(OAID_MODULE_SERVICE, "OnGetAncoAccessRecordsPage End, size=%{public}zu", page.records.size());
+    return ERR_OK;
+}
+
+int32_t OAIDServiceStub::OnGetAncoOAID(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
+{
     std::string oaid = GetAncoOAID();
     if (oaid == "") {
         OAID_HILOGE(OAID_MODULE_SERVICE, "Get AncoOAID failed.");
@@ -551,12 +610,8 @@ int32_t OAIDServiceStub::OnGetAncoOAID(MessageParcel &data, MessageParcel &reply
     return ERR_OK;
 }
 
-int32_t OAIDServiceStub::OnInsertAccessRecord(MessageParcel &data, MessageParcel &reply)
+int32_t OAIDServiceStub::OnInsertAccessRecord(MessageParcel &data, MessageParcel &reply, CallerInfo &caller)
 {
-    if (!CheckBrokerSA()) {
-        OAID_HILOGE(OAID_MODULE_SERVICE, "Check broker sa failed");
-        return ERR_PERMISSION_ERROR;
-    }
     int32_t userId = data.ReadInt32();
     std::string bundleName = data.ReadString();
     std::string uid = data.ReadString();
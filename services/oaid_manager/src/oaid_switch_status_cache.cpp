@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_switch_status_cache.h"
+
+#include <mutex>
+
+namespace OHOS {
+namespace Cloud {
+OaidSwitchStatusCache::Shard &OaidSwitchStatusCache::GetShard(int32_t userId)
+{
+    return shards_[static_cast<uint32_t>(userId) % SHARD_COUNT];
+}
+
+OaidSwitchStatusCache::LookupResult OaidSwitchStatusCache::Lookup(int32_t userId, const std::string &bundleName,
+    const std::string &uid, int32_t &status)
+{
+    Shard &shard = GetShard(userId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    auto userIter = shard.users.find(userId);
+    if (userIter == shard.users.end()) {
+        return LookupResult::NOT_LOADED;
+    }
+    auto bundleIter = userIter->second.find(bundleName);
+    if (bundleIter == userIter->second.end()) {
+        return LookupResult::ABSENT;
+    }
+    auto uidIter = bundleIter->second.find(uid);
+    if (uidIter == bundleIter->second.end()) {
+        return LookupResult::ABSENT;
+    }
+    status = uidIter->second;
+    return LookupResult::FOUND;
+}
+
+bool OaidSwitchStatusCache::IsLoaded(int32_t userId)
+{
+    Shard &shard = GetShard(userId);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.users.find(userId) != shard.users.end();
+}
+
+void OaidSwitchStatusCache::LoadUser(int32_t userId, const std::vector<AncoSwitchStatusInfo> &rows)
+{
+    UserTable table;
+    for (const auto &row : rows) {
+        table[row.bundleName][row.uid] = row.status;
+    }
+    Shard &shard = GetShard(userId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.users[userId] = std::move(table);
+}
+
+void OaidSwitchStatusCache::Put(const AncoSwitchStatusInfo &info)
+{
+    Shard &shard = GetShard(info.userId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto userIter = shard.users.find(info.userId);
+    if (userIter == shard.users.end()) {
+        return;
+    }
+    userIter->second[info.bundleName][info.uid] = info.status;
+}
+
+void OaidSwitchStatusCache::EraseBundles(int32_t userId, const std::vector<std::string> &bundleNames)
+{
+    Shard &shard = GetShard(userId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    auto userIter = shard.users.find(userId);
+    if (userIter == shard.users.end()) {
+        return;
+    }
+    for (const auto &bundleName : bundleNames) {
+        userIter->second.erase(bundleName);
+    }
+}
+
+void OaidSwitchStatusCache::EraseUser(int32_t userId)
+{
+    Shard &shard = GetShard(userId);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    shard.users.erase(userId);
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_under_age_record.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+constexpr size_t BITS_PER_BYTE = 8;
+}  // namespace
+
+std::vector<uint8_t> EncodeUnderAgeRecord(bool allowGetOaid, int64_t updateTime)
+{
+    std::vector<uint8_t> record(UNDER_AGE_RECORD_SIZE, 0);
+    record[0] = UNDER_AGE_RECORD_VERSION;
+    record[UNDER_AGE_RECORD_ALLOW_OFFSET] = allowGetOaid ? 1 : 0;
+    uint64_t time = static_cast<uint64_t>(updateTime);
+    for (size_t i = 0; i < sizeof(int64_t); i++) {
+        record[UNDER_AGE_RECORD_TIME_OFFSET + i] = static_cast<uint8_t>(time >> (i * BITS_PER_BYTE));
+    }
+    return record;
+}
+
+bool DecodeUnderAgeRecord(const std::vector<uint8_t> &record, bool &allowGetOaid, int64_t &updateTime)
+{
+    // Newer versions may only append fields, so a longer record is still readable.
+    if (record.size() < UNDER_AGE_RECORD_SIZE || record[0] < UNDER_AGE_RECORD_VERSION) {
+        return false;
+    }
+    uint64_t time = 0;
+    for (size_t i = 0; i < sizeof(int64_t); i++) {
+        time |= static_cast<uint64_t>(record[UNDER_AGE_RECORD_TIME_OFFSET + i]) << (i * BITS_PER_BYTE);
+    }
+    allowGetOaid = record[UNDER_AGE_RECORD_ALLOW_OFFSET] != 0;
+    updateTime = static_cast<int64_t>(time);
+    return true;
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_uuid_generator.h"
+
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+
+#include "oaid_hilog_wreapper.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+constexpr size_t VERSION_INDEX = 6;        // xxxxxxxx-xxxx-Mxxx-Nxxx-xxxxxxxxxxxx, M is uuid[6] high nibble.
+constexpr size_t VARIANT_INDEX = 8;        // N is uuid[8] high nibble.
+constexpr uint8_t VERSION_4 = 0x40;
+constexpr uint8_t VERSION_CLEAR_MASK = 0x0F;
+constexpr uint8_t VARIANT_RFC4122 = 0x80;  // 10xx, so N is one of 8, 9, a, b with equal probability.
+constexpr uint8_t VARIANT_CLEAR_MASK = 0x3F;
+constexpr uint32_t RESEED_INTERVAL = 16;   // Reseed the DRBG every 16 refills, that is every 1024 UUIDs.
+}  // namespace
+
+OaidUuidGenerator& OaidUuidGenerator::GetInstance()
+{
+    static OaidUuidGenerator instance;
+    return instance;
+}
+
+OaidUuidGenerator::~OaidUuidGenerator()
+{
+    OPENSSL_cleanse(buffer_.data(), buffer_.size());
+}
+
+bool OaidUuidGenerator::RefillLocked()
+{
+    if (refillCount_ % RESEED_INTERVAL == 0 && RAND_poll() != 1) {
+        OAID_HILOGW(OAID_MODULE_COMMON, "RAND_poll failed, keep current seed");
+    }
+    if (RAND_bytes(buffer_.data(), static_cast<int>(buffer_.size())) != 1) {
+        OAID_HILOGE(OAID_MODULE_COMMON, "RAND_bytes failed");
+        return false;
+    }
+    refillCount_++;
+    offset_ = 0;
+    return true;
+}
+
+bool OaidUuidGenerator::Generate(OaidValue &value)
+{
+    std::array<uint8_t, OaidValue::BYTE_SIZE> uuid;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (offset_ >= BUFFER_SIZE && !RefillLocked()) {
+            return false;
+        }
+        uint8_t *slot = buffer_.data() + offset_;
+        for (size_t i = 0; i < OaidValue::BYTE_SIZE; i++) {
+            uuid[i] = slot[i];
+        }
+        // Handed out bytes must not stay in memory.
+        OPENSSL_cleanse(slot, OaidValue::BYTE_SIZE);
+        offset_ += OaidValue::BYTE_SIZE;
+    }
+    uuid[VERSION_INDEX] = (uuid[VERSION_INDEX] & VERSION_CLEAR_MASK) | VERSION_4;
+    uuid[VARIANT_INDEX] = (uuid[VARIANT_INDEX] & VARIANT_CLEAR_MASK) | VARIANT_RFC4122;
+    value = OaidValue::FromBytes(uuid.data());
+    return true;
+}
+}  // namespace Cloud
+}  // namespace OHOS
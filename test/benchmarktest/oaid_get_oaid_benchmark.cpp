@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "accesstoken_kit.h"
+#include "iservice_registry.h"
+#include "oaid_service_client.h"
+#include "oaid_service_interface.h"
+#include "service_control.h"
+#include "token_setproc.h"
+
+using namespace OHOS;
+using namespace OHOS::Cloud;
+
+namespace {
+const std::string OAID_TRACKING_CONSENT_PERMISSION = "ohos.permission.APP_TRACKING_CONSENT";
+const char *OAID_SERVICE_NAME = "oaid_service";  // Service name in oaidservice.cfg.
+constexpr int32_t OAID_SA_ID = 6101;             // The system component ID of the OAID is 6101.
+constexpr int32_t LOAD_TIMEOUT_S = 5;
+constexpr int32_t STOP_TIMEOUT_S = 5;
+constexpr int32_t SAMGR_POLL_COUNT = 500;
+constexpr std::chrono::milliseconds SAMGR_POLL_INTERVAL(10);
+
+// GET_OAID is served to callers holding the tracking consent permission only.
+void GrantTrackingConsent()
+{
+    Security::AccessToken::PermissionDef permDef = {
+        .permissionName = OAID_TRACKING_CONSENT_PERMISSION,
+        .bundleName = "oaid_benchmark",
+        .grantMode = Security::AccessToken::GrantMode::USER_GRANT,
+        .availableLevel = Security::AccessToken::APL_SYSTEM_BASIC,
+        .label = "label",
+        .labelId = 1,
+        .description = "oaid benchmark",
+        .descriptionId = 1,
+    };
+    Security::AccessToken::PermissionStateFull permState = {
+        .isGeneral = true,
+        .grantStatus = {Security::AccessToken::PermissionState::PERMISSION_GRANTED},
+        .permissionName = OAID_TRACKING_CONSENT_PERMISSION,
+        .grantFlags = {Security::AccessToken::PermissionFlag::PERMISSION_USER_FIXED},
+        .resDeviceID = {"local"},
+    };
+    Security::AccessToken::HapInfoParams infoParams = {
+        .userID = 100,
+        .bundleName = "oaid_benchmark",
+        .instIndex = 0,
+        .appIDDesc = "oaid_benchmark",
+        .isSystemApp = true
+    };
+    Security::AccessToken::HapPolicyParams policyParams = {
+        .apl = Security::AccessToken::APL_SYSTEM_BASIC,
+        .domain = "oaid.benchmark",
+        .permList = {permDef},
+        .permStateList = {permState},
+    };
+    auto tokenId = Security::AccessToken::AccessTokenKit::AllocHapToken(infoParams, policyParams);
+    SetSelfTokenID(tokenId.tokenIDEx);
+}
+
+/*
+ * GET_OAID over binder, one caller per benchmark thread. The client cache stays off, so every iteration is one
+ * IPC served by the SA snapshot; throughput should grow with the thread count up to the SA binder pool size.
+ */
+void BM_GetOAIDValue(benchmark::State &state)
+{
+    static std::once_flag setUpOnce;
+    std::call_once(setUpOnce, []() {
+        GrantTrackingConsent();
+        OAIDServiceClient::GetInstance()->SetOAIDCacheEnabled(false);
+        // Load the SA and its snapshot outside of the measurement.
+        benchmark::DoNotOptimize(OAIDServiceClient::GetInstance()->GetOAIDValue());
+    });
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(OAIDServiceClient::GetInstance()->GetOAIDValue());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_GetOAIDValue)->ThreadRange(1, 16)->UseRealTime();
+
+// Stops the SA process and waits until samgr has dropped it, so the next load starts a new process.
+bool StopOaidService(const sptr<ISystemAbilityManager> &samgr)
+{
+    if (ServiceControl(OAID_SERVICE_NAME, STOP) != 0 ||
+        ServiceWaitForStatus(OAID_SERVICE_NAME, SERVICE_STOPPED, STOP_TIMEOUT_S) != 0) {
+        return false;
+    }
+    for (int32_t i = 0; i < SAMGR_POLL_COUNT; i++) {
+        if (samgr->CheckSystemAbility(OAID_SA_ID) == nullptr) {
+            return true;
+        }
+        std::this_thread::sleep_for(SAMGR_POLL_INTERVAL);
+    }
+    return false;
+}
+
+/*
+ * Cold start to first OAID: the SA process is stopped outside of the measurement, the measured part is the
+ * on-demand load (process start, OnStart, publish) plus the first GET_OAID, which opens the state store.
+ * Needs a root shell to stop the service.
+ */
+void BM_ColdStartGetOAID(benchmark::State &state)
+{
+    static std::once_flag setUpOnce;
+    std::call_once(setUpOnce, []() { GrantTrackingConsent(); });
+    auto samgr = SystemAbilityManagerClient::GetInstance().GetSystemAbilityManager();
+    if (samgr == nullptr) {
+        state.SkipWithError("get samgr failed");
+        return;
+    }
+    for (auto _ : state) {
+        if (!StopOaidService(samgr)) {
+            state.SkipWithError("stop oaid service failed");
+            break;
+        }
+        auto begin = std::chrono::steady_clock::now();
+        sptr<IOAIDService> proxy = iface_cast<IOAIDService>(samgr->LoadSystemAbility(OAID_SA_ID, LOAD_TIMEOUT_S));
+        if (proxy == nullptr) {
+            state.SkipWithError("load oaid service failed");
+            break;
+        }
+        uint64_t generation = 0;
+        OaidValue oaid = proxy->GetOAID(generation);
+        auto end = std::chrono::steady_clock::now();
+        if (oaid.IsZero()) {
+            state.SkipWithError("first oaid is empty");
+            break;
+        }
+        state.SetIterationTime(std::chrono::duration<double>(end - begin).count());
+    }
+}
+// Every iteration restarts the SA, a few are enough and the steady state benchmark above runs first.
+BENCHMARK(BM_ColdStartGetOAID)->Iterations(20)->UseManualTime()->Unit(benchmark::kMillisecond);
+}  // namespace
+
+BENCHMARK_MAIN();
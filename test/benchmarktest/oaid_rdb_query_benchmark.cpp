@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "rdb_errno.h"
+#include "rdb_helper.h"
+#include "rdb_open_callback.h"
+#include "rdb_store.h"
+#include "rdb_store_config.h"
+
+using namespace OHOS;
+
+namespace {
+const std::string BENCHMARK_DB_PATH = "/data/test/oaid_rdb_query_benchmark.db";
+const std::string ACCESS_RECORD_TABLE = "anco_a_record";
+constexpr int64_t ONE_MINUTE_MS = 60 * 1000LL;
+constexpr int64_t SEVEN_DAYS_MS = 7 * 24 * 60 * ONE_MINUTE_MS;
+constexpr int64_t RECORD_INTERVAL_MS = 600;  // 10^7 rows span about 70 days, older rows are what retention deletes.
+constexpr int64_t APP_COUNT = 300;
+constexpr int32_t USER_ID = 100;
+
+// Same table and indexes as OaidRdbManager at DB_VERSION_ACCESS_RECORD_INDEX.
+const std::string CREATE_TABLE_SQL = "CREATE TABLE IF NOT EXISTS " + ACCESS_RECORD_TABLE +
+    " (id INTEGER PRIMARY KEY AUTOINCREMENT, user_id INTEGER NOT NULL, bn TEXT NOT NULL, uid TEXT NOT NULL, "
+    "time INTEGER NOT NULL)";
+const std::string CREATE_USER_TIME_INDEX_SQL = "CREATE INDEX IF NOT EXISTS idx_anco_a_record_user_time ON " +
+    ACCESS_RECORD_TABLE + " (user_id, time)";
+const std::string CREATE_USER_APP_TIME_INDEX_SQL = "CREATE INDEX IF NOT EXISTS idx_anco_a_record_user_app_time ON " +
+    ACCESS_RECORD_TABLE + " (user_id, bn, uid, time)";
+
+class BenchmarkOpenCallback : public NativeRdb::RdbOpenCallback {
+public:
+    int OnCreate(NativeRdb::RdbStore &store) override
+    {
+        return store.ExecuteSql(CREATE_TABLE_SQL);
+    }
+    int OnUpgrade(NativeRdb::RdbStore &store, int currentVersion, int targetVersion) override
+    {
+        return NativeRdb::E_OK;
+    }
+};
+
+int64_t GetCurrentTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+struct BenchmarkStore {
+    std::shared_ptr<NativeRdb::RdbStore> store;
+    int64_t rows = -1;
+    bool indexed = false;
+    int64_t now = 0;
+};
+
+// Rebuilt only when the row count or the index setting changes, seeding 10^7 rows takes a while.
+std::shared_ptr<NativeRdb::RdbStore> PrepareStore(int64_t rows, bool indexed, int64_t &now)
+{
+    static BenchmarkStore current;
+    if (current.store != nullptr && current.rows == rows && current.indexed == indexed) {
+        now = current.now;
+        return current.store;
+    }
+    current.store = nullptr;
+    NativeRdb::RdbHelper::DeleteRdbStore(BENCHMARK_DB_PATH);
+    NativeRdb::RdbStoreConfig config(BENCHMARK_DB_PATH);
+    config.SetJournalMode(NativeRdb::JournalMode::MODE_WAL);
+    BenchmarkOpenCallback callback;
+    int errCode = NativeRdb::E_OK;
+    auto store = NativeRdb::RdbHelper::GetRdbStore(config, 1, callback, errCode);
+    if (store == nullptr || errCode != NativeRdb::E_OK) {
+        return nullptr;
+    }
+    current.now = GetCurrentTimeMs();
+    std::vector<NativeRdb::ValueObject> args = { NativeRdb::ValueObject(rows - 1),
+        NativeRdb::ValueObject(current.now) };
+    errCode = store->ExecuteSql("INSERT INTO " + ACCESS_RECORD_TABLE + " (user_id, bn, uid, time) "
+        "WITH RECURSIVE seq(n) AS (SELECT 0 UNION ALL SELECT n + 1 FROM seq WHERE n < ?) "
+        "SELECT " + std::to_string(USER_ID) + ", 'com.example.app' || (n % " + std::to_string(APP_COUNT) + "), "
+        "CAST(20010000 + n % " + std::to_string(APP_COUNT) + " AS TEXT), ? - n * " +
+        std::to_string(RECORD_INTERVAL_MS) + " FROM seq", args);
+    if (errCode != NativeRdb::E_OK) {
+        return nullptr;
+    }
+    if (indexed && (store->ExecuteSql(CREATE_USER_TIME_INDEX_SQL) != NativeRdb::E_OK ||
+        store->ExecuteSql(CREATE_USER_APP_TIME_INDEX_SQL) != NativeRdb::E_OK)) {
+        return nullptr;
+    }
+    store->ExecuteSql("ANALYZE");
+    current.store = store;
+    current.rows = rows;
+    current.indexed = indexed;
+    now = current.now;
+    return store;
+}
+
+int64_t CountRows(const std::shared_ptr<NativeRdb::RdbStore> &store, const std::string &sql,
+    const std::vector<NativeRdb::ValueObject> &args)
+{
+    auto resultSet = store->QuerySql(sql, args);
+    if (resultSet == nullptr) {
+        return -1;
+    }
+    int64_t count = 0;
+    while (resultSet->GoToNextRow() == NativeRdb::E_OK) {
+        count++;
+    }
+    resultSet->Close();
+    return count;
+}
+
+/*
+ * The 7 day raw records of one app, the query QueryAccessRecords used before the minute rollup.
+ * Args: table rows, 1 with the migration indexes / 0 without.
+ */
+void BM_QueryAppAccessRecords(benchmark::State &state)
+{
+    int64_t now = 0;
+    auto store = PrepareStore(state.range(0), state.range(1) != 0, now);
+    if (store == nullptr) {
+        state.SkipWithError("prepare store failed");
+        return;
+    }
+    const std::string sql = "SELECT user_id, bn, uid, time FROM " + ACCESS_RECORD_TABLE +
+        " WHERE user_id = ? AND bn = ? AND uid = ? AND time >= ? ORDER BY time";
+    const std::vector<NativeRdb::ValueObject> args = { NativeRdb::ValueObject(USER_ID),
+        NativeRdb::ValueObject(std::string("com.example.app7")), NativeRdb::ValueObject(std::string("20010007")),
+        NativeRdb::ValueObject(now - SEVEN_DAYS_MS) };
+    int64_t rows = 0;
+    for (auto _ : state) {
+        rows = CountRows(store, sql, args);
+    }
+    state.counters["resultRows"] = static_cast<double>(rows);
+}
+
+/*
+ * The distinct apps of one user, what the uninstalled-app reconcile reads.
+ */
+void BM_QueryUserBundleNames(benchmark::State &state)
+{
+    int64_t now = 0;
+    auto store = PrepareStore(state.range(0), state.range(1) != 0, now);
+    if (store == nullptr) {
+        state.SkipWithError("prepare store failed");
+        return;
+    }
+    const std::string sql = "SELECT DISTINCT bn FROM " + ACCESS_RECORD_TABLE + " WHERE user_id = ?";
+    int64_t rows = 0;
+    for (auto _ : state) {
+        rows = CountRows(store, sql, { NativeRdb::ValueObject(USER_ID) });
+    }
+    state.counters["resultRows"] = static_cast<double>(rows);
+}
+
+void RowCountArgs(benchmark::internal::Benchmark *benchmark)
+{
+    constexpr int64_t minRows = 100000;
+    constexpr int64_t maxRows = 10000000;
+    constexpr int64_t rowMultiplier = 10;
+    for (int64_t rows = minRows; rows <= maxRows; rows *= rowMultiplier) {
+        benchmark->Args({ rows, 0 });
+        benchmark->Args({ rows, 1 });
+    }
+}
+BENCHMARK(BM_QueryAppAccessRecords)->Apply(RowCountArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_QueryUserBundleNames)->Apply(RowCountArgs)->Unit(benchmark::kMicrosecond);
+}  // namespace
+
+BENCHMARK_MAIN();
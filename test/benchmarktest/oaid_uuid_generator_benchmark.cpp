@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include <openssl/rand.h>
+
+#include "oaid_uuid_generator.h"
+#include "oaid_value.h"
+
+using namespace OHOS::Cloud;
+
+namespace {
+char HexToChar(uint8_t hex)
+{
+    static const uint8_t MAX_SINGLE_DIGIT = 9;  // 9 is the largest single digit
+    return (hex > MAX_SINGLE_DIGIT) ? (hex + 0x57) : (hex + 0x30);
+}
+
+// The GetUUID the service used before OaidUuidGenerator, kept as it was apart from the logging.
+std::string BaselineGetUUID()
+{
+    static const int8_t UUID_LENGTH = 16;    // The UUID is 128 bits, that is 16 bytes.
+    static const int8_t VERSION_INDEX = 6;   // Obtain the seventh byte of the randomly generated UUID, that is uuid[6].
+    static const int8_t CHAR_LOW_WIDTH = 4;  // Lower 4 bits of the char type
+    static const int8_t N_INDEX = 8;         // Reset the ninth byte of the UUID, that is UUID[8].
+    unsigned char uuid[UUID_LENGTH] = {0};
+    if (RAND_bytes(uuid, sizeof(uuid)) != 1) {
+        return "";
+    }
+    uuid[VERSION_INDEX] = (uuid[VERSION_INDEX] & 0x0F) | 0x40;
+    int minN = 0x8;
+    int maxN = 0xb;
+    unsigned char randNumber[1] = {minN};
+    if (RAND_bytes(randNumber, sizeof(randNumber)) != 1) {
+        return "";
+    }
+    unsigned char num = static_cast<unsigned char>(randNumber[0] % (maxN - minN + 1) + minN);
+    uuid[N_INDEX] = (uuid[N_INDEX] & 0x0F) | (num << CHAR_LOW_WIDTH);
+
+    static const size_t LINE_INDEX_MAX = 10;  // until i=10
+    static const size_t LINE_INDEX_MIN = 4;   // Add a hyphen (-) every two bytes starting from i=4.
+    static const size_t EVEN_FACTOR = 2;  // the even factor is assigned to 2, and all even numbers are divisible by 2.
+    std::string formatUuid = "";
+    for (size_t i = 0; i < sizeof(uuid); i++) {
+        unsigned char value = uuid[i];
+        if (i >= LINE_INDEX_MIN && i <= LINE_INDEX_MAX && i % EVEN_FACTOR == 0) {
+            formatUuid += "-";
+        }
+        formatUuid += HexToChar(value >> CHAR_LOW_WIDTH);
+        unsigned char highValue = value & 0xF0;
+        if (highValue == 0) {
+            formatUuid += HexToChar(value);
+        } else {
+            formatUuid += HexToChar(value % (value & highValue));
+        }
+    }
+    return formatUuid;
+}
+
+/*
+ * Baseline: two RAND_bytes calls and a string build per UUID.
+ */
+void BM_BaselineGetUUID(benchmark::State &state)
+{
+    for (auto _ : state) {
+        std::string uuid = BaselineGetUUID();
+        benchmark::DoNotOptimize(uuid);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * OaidUuidGenerator: one RAND_bytes call every 64 UUIDs, the rest is a 16 byte copy under the generator mutex.
+ */
+void BM_OaidUuidGeneratorGenerate(benchmark::State &state)
+{
+    OaidValue value;
+    for (auto _ : state) {
+        if (!OaidUuidGenerator::GetInstance().Generate(value)) {
+            state.SkipWithError("Generate failed");
+            break;
+        }
+        benchmark::DoNotOptimize(value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+/*
+ * Generate plus ToString, the same string output the baseline produces.
+ */
+void BM_OaidUuidGeneratorGenerateToString(benchmark::State &state)
+{
+    OaidValue value;
+    for (auto _ : state) {
+        if (!OaidUuidGenerator::GetInstance().Generate(value)) {
+            state.SkipWithError("Generate failed");
+            break;
+        }
+        std::string uuid = value.ToString();
+        benchmark::DoNotOptimize(uuid);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Single thread first, then up to 16 threads contending on the RAND lock or on the generator mutex.
+BENCHMARK(BM_BaselineGetUUID)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_OaidUuidGeneratorGenerate)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_OaidUuidGeneratorGenerateToString)->ThreadRange(1, 16)->UseRealTime();
+}  // namespace
+
+BENCHMARK_MAIN();
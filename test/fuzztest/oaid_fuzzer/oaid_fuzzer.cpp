@@ -17,6 +17,7 @@
 
 #include <string>
 #include <vector>
+#define private public
 #include "oaid_service_stub.h"
 #include "oaid_service.h"
 #include "oaid_hilog_wreapper.h"
@@ -88,7 +89,11 @@ namespace OHOS {
     bool OAIDFuzzTest(const uint8_t* rawData, size_t size)
     {
         uint32_t startCode = static_cast<uint32_t>(OHOS::Cloud::OAIDInterfaceCode::GET_OAID);
-        uint32_t endCode = static_cast<uint32_t>(OHOS::Cloud::OAIDInterfaceCode::REGISTER_CONTROL_CONFIG_OBSERVER) + 1;
+        // Every code of the stub's CODE_TABLE, plus the first code without a handler.
+        uint32_t endCode = startCode;
+        while (Cloud::OAIDServiceStub::FindCodeEntry(endCode) != nullptr) {
+            endCode++;
+        }
         for (uint32_t code = startCode; code <= endCode; code++) {
             MessageParcel data;
             data.WriteInterfaceToken(OAID_INTERFACE_TOKEN);
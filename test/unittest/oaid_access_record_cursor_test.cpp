@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "oaid_access_record_cursor.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Cloud {
+class OaidAccessRecordCursorTest : public testing::Test {};
+
+/**
+ * @tc.name: OaidAccessRecordCursorTest001
+ * @tc.desc: A cursor decodes to the key it was encoded from, separators inside the uid or bundle name included.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidAccessRecordCursorTest, OaidAccessRecordCursorTest001, TestSize.Level1)
+{
+    struct Key {
+        int64_t firstTime;
+        std::string bundleName;
+        std::string uid;
+    };
+    const std::vector<Key> keys = {
+        { 1767225600123, "com.example.app", "20010042" },
+        { 0, "b", "" },
+        { -1, "com,example", "1,2," },
+    };
+    for (const auto& key : keys) {
+        std::string text = EncodeAccessRecordCursor(key.firstTime, key.bundleName, key.uid);
+        AccessRecordCursor cursor;
+        ASSERT_TRUE(DecodeAccessRecordCursor(text, cursor)) << text;
+        EXPECT_EQ(cursor.firstTime, key.firstTime);
+        EXPECT_EQ(cursor.bundleName, key.bundleName);
+        EXPECT_EQ(cursor.uid, key.uid);
+    }
+    EXPECT_EQ(EncodeAccessRecordCursor(12, "bn", "uid"), "12,3,uidbn");
+}
+
+/**
+ * @tc.name: OaidAccessRecordCursorTest002
+ * @tc.desc: Malformed cursors are rejected.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidAccessRecordCursorTest, OaidAccessRecordCursorTest002, TestSize.Level1)
+{
+    const std::vector<std::string> malformed = {
+        "",
+        "12",
+        "12,",
+        "x,3,uidbn",
+        "12,x,uidbn",
+        "12,3",
+        "12,3uidbn",
+        "12,3,uid",
+        "12,99,uidbn",
+        "12,18446744073709551616,uidbn",
+        "99999999999999999999,3,uidbn",
+    };
+    for (const auto& text : malformed) {
+        AccessRecordCursor cursor;
+        EXPECT_FALSE(DecodeAccessRecordCursor(text, cursor)) << text;
+    }
+}
+}  // namespace Cloud
+}  // namespace OHOS
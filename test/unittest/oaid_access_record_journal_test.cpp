@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "oaid_access_record_journal.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+const std::string TEST_JOURNAL_PATH = "/data/test/oaid_access_record_journal_test.journal";
+constexpr size_t TEST_CAPACITY = 4;
+constexpr off_t SLOT_SIZE = 256;  // The journal header takes the first slot sized block.
+
+AccessRecordEntry MakeEntry(int64_t time)
+{
+    AccessRecordEntry entry;
+    entry.userId = 100;
+    entry.bundleName = "com.example.app" + std::to_string(time);
+    entry.uid = std::to_string(20010000 + time);
+    entry.time = time;
+    return entry;
+}
+
+std::vector<int64_t> PeekTimes(OaidAccessRecordJournal &journal, size_t maxCount)
+{
+    std::vector<AccessRecordEntry> batch;
+    journal.PeekBatch(batch, maxCount);
+    std::vector<int64_t> times;
+    for (const auto &entry : batch) {
+        times.push_back(entry.time);
+    }
+    return times;
+}
+}  // namespace
+
+class OaidAccessRecordJournalTest : public testing::Test {
+public:
+    void SetUp() override
+    {
+        (void)unlink(TEST_JOURNAL_PATH.c_str());
+    }
+
+    void TearDown() override
+    {
+        SetUp();
+    }
+};
+
+/**
+ * @tc.name: OaidAccessRecordJournalTest001
+ * @tc.desc: Records come out oldest first, the ring rejects appends once full and accepts them after Release.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidAccessRecordJournalTest, OaidAccessRecordJournalTest001, TestSize.Level1)
+{
+    OaidAccessRecordJournal journal;
+    EXPECT_EQ(journal.Open(TEST_JOURNAL_PATH, TEST_CAPACITY), 0u);
+    size_t pendingCount = 0;
+    for (int64_t time = 1; time <= static_cast<int64_t>(TEST_CAPACITY); time++) {
+        ASSERT_TRUE(journal.Append(MakeEntry(time), pendingCount));
+        EXPECT_EQ(pendingCount, static_cast<size_t>(time));
+    }
+    EXPECT_FALSE(journal.Append(MakeEntry(5), pendingCount));
+    EXPECT_EQ(PeekTimes(journal, 2), std::vector<int64_t>({ 1, 2 }));
+    journal.Release(2);
+    ASSERT_TRUE(journal.Append(MakeEntry(5), pendingCount));
+    ASSERT_TRUE(journal.Append(MakeEntry(6), pendingCount));
+    EXPECT_EQ(PeekTimes(journal, TEST_CAPACITY), std::vector<int64_t>({ 3, 4, 5, 6 }));
+    journal.Release(TEST_CAPACITY);
+    EXPECT_EQ(journal.PendingCount(), 0u);
+}
+
+/**
+ * @tc.name: OaidAccessRecordJournalTest002
+ * @tc.desc: Records that were not released are replayed by the next Open, in order, across the ring wrap.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidAccessRecordJournalTest, OaidAccessRecordJournalTest002, TestSize.Level1)
+{
+    size_t pendingCount = 0;
+    {
+        OaidAccessRecordJournal journal;
+        journal.Open(TEST_JOURNAL_PATH, TEST_CAPACITY);
+        for (int64_t time = 1; time <= 3; time++) {
+            ASSERT_TRUE(journal.Append(MakeEntry(time), pendingCount));
+        }
+        journal.Release(2);
+        for (int64_t time = 4; time <= 6; time++) {
+            ASSERT_TRUE(journal.Append(MakeEntry(time), pendingCount));
+        }
+    }
+    OaidAccessRecordJournal journal;
+    EXPECT_EQ(journal.Open(TEST_JOURNAL_PATH, TEST_CAPACITY), 4u);
+    std::vector<AccessRecordEntry> batch;
+    ASSERT_EQ(journal.PeekBatch(batch, TEST_CAPACITY), 4u);
+    EXPECT_EQ(batch[0].userId, 100);
+    EXPECT_EQ(batch[0].bundleName, "com.example.app3");
+    EXPECT_EQ(batch[0].uid, "20010003");
+    EXPECT_EQ(PeekTimes(journal, TEST_CAPACITY), std::vector<int64_t>({ 3, 4, 5, 6 }));
+    EXPECT_FALSE(journal.Append(MakeEntry(7), pendingCount));
+}
+
+/**
+ * @tc.name: OaidAccessRecordJournalTest003
+ * @tc.desc: A torn slot is dropped on replay and skipped as a gap, the records around it are kept.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidAccessRecordJournalTest, OaidAccessRecordJournalTest003, TestSize.Level1)
+{
+    size_t pendingCount = 0;
+    {
+        OaidAccessRecordJournal journal;
+        journal.Open(TEST_JOURNAL_PATH, TEST_CAPACITY);
+        for (int64_t time = 1; time <= 3; time++) {
+            ASSERT_TRUE(journal.Append(MakeEntry(time), pendingCount));
+        }
+    }
+    // Sequence 2 lives in slot 2 % capacity, flip a byte of its bundle name so the checksum no longer matches.
+    int fd = open(TEST_JOURNAL_PATH.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    const char torn = '#';
+    constexpr off_t bundleNameOffset = 24;
+    EXPECT_EQ(pwrite(fd, &torn, 1, SLOT_SIZE * (1 + 2 % TEST_CAPACITY) + bundleNameOffset), 1);
+    close(fd);
+
+    OaidAccessRecordJournal journal;
+    EXPECT_EQ(journal.Open(TEST_JOURNAL_PATH, TEST_CAPACITY), 2u);
+    EXPECT_EQ(PeekTimes(journal, 1), std::vector<int64_t>({ 1 }));
+    journal.Release(1);
+    EXPECT_EQ(PeekTimes(journal, TEST_CAPACITY), std::vector<int64_t>({ 3 }));
+    journal.Release(1);
+    EXPECT_EQ(journal.PendingCount(), 0u);
+    ASSERT_TRUE(journal.Append(MakeEntry(4), pendingCount));
+    EXPECT_EQ(pendingCount, 1u);
+}
+
+/**
+ * @tc.name: OaidAccessRecordJournalTest004
+ * @tc.desc: A journal written with another capacity is discarded instead of misread.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidAccessRecordJournalTest, OaidAccessRecordJournalTest004, TestSize.Level1)
+{
+    size_t pendingCount = 0;
+    {
+        OaidAccessRecordJournal journal;
+        journal.Open(TEST_JOURNAL_PATH, TEST_CAPACITY);
+        ASSERT_TRUE(journal.Append(MakeEntry(1), pendingCount));
+    }
+    OaidAccessRecordJournal journal;
+    EXPECT_EQ(journal.Open(TEST_JOURNAL_PATH, TEST_CAPACITY * 2), 0u);
+    EXPECT_EQ(journal.PendingCount(), 0u);
+}
+
+/**
+ * @tc.name: OaidAccessRecordJournalTest005
+ * @tc.desc: Records that do not fit a slot are refused.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidAccessRecordJournalTest, OaidAccessRecordJournalTest005, TestSize.Level1)
+{
+    OaidAccessRecordJournal journal;
+    journal.Open(TEST_JOURNAL_PATH, TEST_CAPACITY);
+    AccessRecordEntry entry = MakeEntry(1);
+    entry.bundleName.assign(OaidAccessRecordJournal::MAX_BUNDLE_NAME_LENGTH + 1, 'a');
+    size_t pendingCount = 0;
+    EXPECT_FALSE(journal.Append(entry, pendingCount));
+    EXPECT_EQ(journal.PendingCount(), 0u);
+}
+}  // namespace Cloud
+}  // namespace OHOS
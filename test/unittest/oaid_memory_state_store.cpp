@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "oaid_memory_state_store.h"
+
+namespace OHOS {
+namespace Cloud {
+OaidStateStoreStatus OaidMemoryStateStore::Get(const std::string &key, std::vector<uint8_t> &value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+        return OaidStateStoreStatus::NOT_FOUND;
+    }
+    value = iter->second;
+    return OaidStateStoreStatus::SUCCESS;
+}
+
+bool OaidMemoryStateStore::Put(const std::string &key, const std::vector<uint8_t> &value)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_[key] = value;
+    return true;
+}
+
+bool OaidMemoryStateStore::Delete(const std::string &key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.erase(key);
+    return true;
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_MEMORY_STATE_STORE_H
+#define OHOS_CLOUD_OAID_MEMORY_STATE_STORE_H
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "oaid_state_store.h"
+
+namespace OHOS {
+namespace Cloud {
+/**
+ * Process local state store for the unit tests, nothing survives a restart. The service does not offer it as a
+ * backend: the OAID would change on every idle unload.
+ */
+class OaidMemoryStateStore : public IOaidStateStore {
+public:
+    OaidMemoryStateStore() = default;
+    ~OaidMemoryStateStore() override = default;
+
+    OaidStateStoreStatus Get(const std::string &key, std::vector<uint8_t> &value) override;
+    bool Put(const std::string &key, const std::vector<uint8_t> &value) override;
+    bool Delete(const std::string &key) override;
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, std::vector<uint8_t>> entries_;
+};
+}  // namespace Cloud
+}  // namespace OHOS
+
+#endif  // OHOS_CLOUD_OAID_MEMORY_STATE_STORE_H
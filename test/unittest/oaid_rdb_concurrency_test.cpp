@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "rdb_errno.h"
+#include "rdb_helper.h"
+#include "rdb_open_callback.h"
+#include "rdb_store.h"
+#include "rdb_store_config.h"
+
+#define private public
+#include "oaid_rdb_manager.h"
+#undef private
+#include "oaid_common.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+constexpr int32_t TEST_USER_ID = 100;
+constexpr int READ_CONNECTION_SIZE = 4;
+constexpr size_t READER_COUNT = 4;
+constexpr int64_t FLUSH_BATCH_SIZE = 256;   // ACCESS_RECORD_FLUSH_BATCH_SIZE of OaidRdbManager.
+constexpr size_t JOURNAL_CAPACITY = 1024;
+constexpr int64_t SWITCH_STATUS_ROWS = 1000;
+const std::string TEST_DB_PATH = "/data/test/oaid_rdb_concurrency_test.db";
+const std::string TEST_JOURNAL_PATH = "/data/test/oaid_rdb_concurrency_test.journal";
+
+// Same tables as OaidRdbManager at its current version.
+const std::vector<std::string> CREATE_TABLE_SQLS = {
+    "CREATE TABLE IF NOT EXISTS anco_s_status (user_id INTEGER NOT NULL, bn TEXT NOT NULL, uid TEXT NOT NULL, "
+    "res INTEGER NOT NULL DEFAULT 0, create_time INTEGER NOT NULL, update_time INTEGER NOT NULL, "
+    "PRIMARY KEY (user_id, bn, uid))",
+    "CREATE TABLE IF NOT EXISTS anco_a_record (id INTEGER PRIMARY KEY AUTOINCREMENT, user_id INTEGER NOT NULL, "
+    "bn TEXT NOT NULL, uid TEXT NOT NULL, time INTEGER NOT NULL)",
+    "CREATE TABLE IF NOT EXISTS anco_a_minute (user_id INTEGER NOT NULL, bn TEXT NOT NULL, uid TEXT NOT NULL, "
+    "minute INTEGER NOT NULL, first_time INTEGER NOT NULL, burst_start INTEGER NOT NULL, "
+    "cnt INTEGER NOT NULL DEFAULT 1, PRIMARY KEY (user_id, bn, uid, minute))",
+};
+
+class TestOpenCallback : public NativeRdb::RdbOpenCallback {
+public:
+    int OnCreate(NativeRdb::RdbStore &store) override
+    {
+        for (const auto &sql : CREATE_TABLE_SQLS) {
+            int ret = store.ExecuteSql(sql);
+            if (ret != NativeRdb::E_OK) {
+                return ret;
+            }
+        }
+        return NativeRdb::E_OK;
+    }
+    int OnUpgrade(NativeRdb::RdbStore &store, int currentVersion, int targetVersion) override
+    {
+        return NativeRdb::E_OK;
+    }
+};
+
+int64_t CountRows(const std::shared_ptr<NativeRdb::RdbStore> &store, const std::string &table)
+{
+    auto resultSet = store->QuerySql("SELECT COUNT(*) FROM " + table, {});
+    if (resultSet == nullptr) {
+        return -1;
+    }
+    int64_t count = -1;
+    if (resultSet->GoToFirstRow() == NativeRdb::E_OK) {
+        resultSet->GetLong(0, count);
+    }
+    resultSet->Close();
+    return count;
+}
+
+/*
+ * Readers loop until the writer is done and record what they saw. A count outside the allowed steps means a
+ * reader saw part of a transaction, a smaller count than before means a read went back in time.
+ */
+struct ReaderResult {
+    int64_t reads = 0;
+    bool torn = false;
+    bool wentBack = false;
+};
+}  // namespace
+
+class OaidRdbConcurrencyTest : public testing::Test {
+public:
+    static void SetUpTestCase()
+    {
+        (void)unlink(TEST_JOURNAL_PATH.c_str());
+        // The journal opens once per process, every test leaves it drained.
+        OaidRdbManager::GetInstance().journal_.Open(TEST_JOURNAL_PATH, JOURNAL_CAPACITY);
+    }
+
+    static void TearDownTestCase()
+    {
+        (void)unlink(TEST_JOURNAL_PATH.c_str());
+    }
+
+    void SetUp() override
+    {
+        NativeRdb::RdbHelper::DeleteRdbStore(TEST_DB_PATH);
+        // Opened like OaidRdbManager::OpenStoreLocked: WAL with a pool of read connections.
+        NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
+        config.SetJournalMode(NativeRdb::JournalMode::MODE_WAL);
+        config.SetReadConSize(READ_CONNECTION_SIZE);
+        TestOpenCallback callback;
+        int errCode = NativeRdb::E_OK;
+        store_ = NativeRdb::RdbHelper::GetRdbStore(config, 1, callback, errCode);
+        ASSERT_NE(store_, nullptr);
+        // The manager of the test process is pointed at the test store, the service database is not touched.
+        OaidRdbManager::GetInstance().rdbStore_ = store_;
+    }
+
+    void TearDown() override
+    {
+        OaidRdbManager::GetInstance().rdbStore_ = nullptr;
+        store_ = nullptr;
+        NativeRdb::RdbHelper::DeleteRdbStore(TEST_DB_PATH);
+    }
+
+    std::shared_ptr<NativeRdb::RdbStore> store_;
+};
+
+/**
+ * @tc.name: OaidRdbConcurrencyTest001
+ * @tc.desc: While FlushAccessRecords commits a full journal in batches, readers on the WAL connections and
+ *           readers through the manager only ever see whole batches, and each sees the count grow.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidRdbConcurrencyTest, OaidRdbConcurrencyTest001, TestSize.Level1)
+{
+    auto &manager = OaidRdbManager::GetInstance();
+    int64_t baseTime = 1700000000000;
+    size_t pendingCount = 0;
+    for (size_t i = 0; i < JOURNAL_CAPACITY; i++) {
+        AccessRecordEntry entry;
+        entry.userId = TEST_USER_ID;
+        // One bundle per flush batch, so the distinct bundle count is the number of committed batches.
+        entry.bundleName = "com.example.app" + std::to_string(static_cast<int64_t>(i) / FLUSH_BATCH_SIZE);
+        entry.uid = std::to_string(i);
+        entry.time = baseTime + static_cast<int64_t>(i);
+        ASSERT_TRUE(manager.journal_.Append(entry, pendingCount));
+    }
+    const int64_t totalRecords = static_cast<int64_t>(JOURNAL_CAPACITY);
+    const int64_t totalBatches = totalRecords / FLUSH_BATCH_SIZE;
+
+    std::atomic<bool> flushDone {false};
+    std::vector<ReaderResult> results(READER_COUNT);
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < READER_COUNT; r++) {
+        readers.emplace_back([&, r]() {
+            ReaderResult &result = results[r];
+            int64_t lastCount = 0;
+            int64_t lastBatches = 0;
+            do {
+                // Half of the readers go straight to a WAL connection, the others take the manager's shared lock.
+                if (r % 2 == 0) {
+                    int64_t count = CountRows(store_, "anco_a_record");
+                    result.torn = result.torn || count < 0 || count % FLUSH_BATCH_SIZE != 0;
+                    result.wentBack = result.wentBack || count < lastCount;
+                    lastCount = count;
+                } else {
+                    int64_t batches = static_cast<int64_t>(manager.QueryAllBundleNames(TEST_USER_ID).size());
+                    result.torn = result.torn || batches > totalBatches;
+                    result.wentBack = result.wentBack || batches < lastBatches;
+                    lastBatches = batches;
+                }
+                result.reads++;
+            } while (!flushDone.load());
+        });
+    }
+    int32_t ret = manager.FlushAccessRecords();
+    flushDone.store(true);
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(ret, ERR_OK);
+    EXPECT_EQ(manager.journal_.PendingCount(), 0u);
+    EXPECT_EQ(CountRows(store_, "anco_a_record"), totalRecords);
+    EXPECT_EQ(static_cast<int64_t>(manager.QueryAllBundleNames(TEST_USER_ID).size()), totalBatches);
+    for (const auto &result : results) {
+        EXPECT_GT(result.reads, 0);
+        EXPECT_FALSE(result.torn);
+        EXPECT_FALSE(result.wentBack);
+    }
+}
+
+/**
+ * @tc.name: OaidRdbConcurrencyTest002
+ * @tc.desc: Readers on the WAL connections see none or all rows of a switch status batch while it is written.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidRdbConcurrencyTest, OaidRdbConcurrencyTest002, TestSize.Level1)
+{
+    std::vector<AncoSwitchStatusInfo> infos;
+    for (int64_t i = 0; i < SWITCH_STATUS_ROWS; i++) {
+        infos.push_back({ TEST_USER_ID, "com.example.app" + std::to_string(i), std::to_string(i), 1 });
+    }
+    std::atomic<bool> writeDone {false};
+    std::vector<ReaderResult> results(READER_COUNT);
+    std::vector<std::thread> readers;
+    for (size_t r = 0; r < READER_COUNT; r++) {
+        readers.emplace_back([&, r]() {
+            ReaderResult &result = results[r];
+            int64_t lastCount = 0;
+            do {
+                int64_t count = CountRows(store_, "anco_s_status");
+                result.torn = result.torn || (count != 0 && count != SWITCH_STATUS_ROWS);
+                result.wentBack = result.wentBack || count < lastCount;
+                lastCount = count;
+                result.reads++;
+            } while (!writeDone.load());
+        });
+    }
+    int32_t ret = OaidRdbManager::GetInstance().InsertOrReplaceSwitchStatusBatch(infos);
+    writeDone.store(true);
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(ret, ERR_OK);
+    EXPECT_EQ(CountRows(store_, "anco_s_status"), SWITCH_STATUS_ROWS);
+    for (const auto &result : results) {
+        EXPECT_GT(result.reads, 0);
+        EXPECT_FALSE(result.torn);
+        EXPECT_FALSE(result.wentBack);
+    }
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <memory>
+#include <unistd.h>
+
+#include "oaid_file_state_store.h"
+#include "oaid_importing_state_store.h"
+#include "oaid_memory_state_store.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+const std::string TEST_STATE_PATH = "/data/test/oaid_state_store_test.state";
+const std::string TEST_CORRUPT_PATH = TEST_STATE_PATH + ".corrupt";
+}  // namespace
+
+class OaidStateStoreTest : public testing::Test {
+public:
+    void SetUp() override
+    {
+        (void)unlink(TEST_STATE_PATH.c_str());
+        (void)unlink(TEST_CORRUPT_PATH.c_str());
+    }
+
+    void TearDown() override
+    {
+        SetUp();
+    }
+};
+
+/**
+ * @tc.name: OaidFileStateStoreTest001
+ * @tc.desc: A missing file is an empty store, written entries survive a reopen.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidStateStoreTest, OaidFileStateStoreTest001, TestSize.Level1)
+{
+    std::vector<uint8_t> value;
+    {
+        OaidFileStateStore store(TEST_STATE_PATH);
+        EXPECT_EQ(store.Get("oaid_key", value), OaidStateStoreStatus::NOT_FOUND);
+        EXPECT_TRUE(store.Put("oaid_key", { 1, 2, 3 }));
+        EXPECT_TRUE(store.Put("empty", {}));
+        EXPECT_TRUE(store.Put("gone", { 4 }));
+        EXPECT_TRUE(store.Delete("gone"));
+        EXPECT_TRUE(store.Delete("never_written"));
+    }
+    OaidFileStateStore store(TEST_STATE_PATH);
+    ASSERT_EQ(store.Get("oaid_key", value), OaidStateStoreStatus::SUCCESS);
+    EXPECT_EQ(value, std::vector<uint8_t>({ 1, 2, 3 }));
+    ASSERT_EQ(store.Get("empty", value), OaidStateStoreStatus::SUCCESS);
+    EXPECT_TRUE(value.empty());
+    EXPECT_EQ(store.Get("gone", value), OaidStateStoreStatus::NOT_FOUND);
+}
+
+/**
+ * @tc.name: OaidFileStateStoreTest002
+ * @tc.desc: A malformed file is set aside and the store starts empty.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidStateStoreTest, OaidFileStateStoreTest002, TestSize.Level1)
+{
+    FILE *file = fopen(TEST_STATE_PATH.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    (void)fputs("not a state file", file);
+    (void)fclose(file);
+
+    OaidFileStateStore store(TEST_STATE_PATH);
+    std::vector<uint8_t> value;
+    EXPECT_EQ(store.Get("oaid_key", value), OaidStateStoreStatus::NOT_FOUND);
+    EXPECT_EQ(access(TEST_CORRUPT_PATH.c_str(), F_OK), 0);
+    EXPECT_TRUE(store.Put("oaid_key", { 1 }));
+}
+
+/**
+ * @tc.name: OaidFileStateStoreTest003
+ * @tc.desc: A file that can not be opened reports ERROR and refuses writes instead of starting empty.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidStateStoreTest, OaidFileStateStoreTest003, TestSize.Level1)
+{
+    FILE *file = fopen(TEST_STATE_PATH.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    (void)fclose(file);
+
+    // A path below a regular file fails with ENOTDIR, unlike a missing file.
+    OaidFileStateStore store(TEST_STATE_PATH + "/sub.state");
+    std::vector<uint8_t> value;
+    EXPECT_EQ(store.Get("oaid_key", value), OaidStateStoreStatus::ERROR);
+    EXPECT_FALSE(store.Put("oaid_key", { 1 }));
+    EXPECT_FALSE(store.Delete("oaid_key"));
+}
+
+/**
+ * @tc.name: OaidImportingStateStoreTest001
+ * @tc.desc: Missing keys are imported from the previous backend once, values already in the target win.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidStateStoreTest, OaidImportingStateStoreTest001, TestSize.Level1)
+{
+    auto target = std::make_shared<OaidMemoryStateStore>();
+    auto source = std::make_shared<OaidMemoryStateStore>();
+    EXPECT_TRUE(source->Put("oaid_key", { 1 }));
+    EXPECT_TRUE(source->Put("kept", { 2 }));
+    EXPECT_TRUE(source->Put("not_listed", { 3 }));
+    EXPECT_TRUE(target->Put("kept", { 9 }));
+
+    std::vector<uint8_t> value;
+    {
+        OaidImportingStateStore store(target, source, { "oaid_key", "kept", "absent" });
+        ASSERT_EQ(store.Get("oaid_key", value), OaidStateStoreStatus::SUCCESS);
+        EXPECT_EQ(value, std::vector<uint8_t>({ 1 }));
+        ASSERT_EQ(store.Get("kept", value), OaidStateStoreStatus::SUCCESS);
+        EXPECT_EQ(value, std::vector<uint8_t>({ 9 }));
+        EXPECT_EQ(store.Get("not_listed", value), OaidStateStoreStatus::NOT_FOUND);
+        EXPECT_EQ(store.Get("absent", value), OaidStateStoreStatus::NOT_FOUND);
+        EXPECT_TRUE(store.Delete("oaid_key"));
+    }
+    // The import ran to completion, a new process must not bring the deleted key back.
+    OaidImportingStateStore store(target, source, { "oaid_key" });
+    EXPECT_EQ(store.Get("oaid_key", value), OaidStateStoreStatus::NOT_FOUND);
+}
+
+/**
+ * @tc.name: OaidImportingStateStoreTest002
+ * @tc.desc: A source that fails to read leaves the import unfinished, the next start tries it again.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidStateStoreTest, OaidImportingStateStoreTest002, TestSize.Level1)
+{
+    FILE *file = fopen(TEST_STATE_PATH.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    (void)fclose(file);
+    auto target = std::make_shared<OaidMemoryStateStore>();
+    std::vector<uint8_t> value;
+    {
+        auto brokenSource = std::make_shared<OaidFileStateStore>(TEST_STATE_PATH + "/sub.state");
+        OaidImportingStateStore store(target, brokenSource, { "oaid_key" });
+        EXPECT_EQ(store.Get("oaid_key", value), OaidStateStoreStatus::NOT_FOUND);
+    }
+    auto source = std::make_shared<OaidMemoryStateStore>();
+    EXPECT_TRUE(source->Put("oaid_key", { 5 }));
+    OaidImportingStateStore store(target, source, { "oaid_key" });
+    ASSERT_EQ(store.Get("oaid_key", value), OaidStateStoreStatus::SUCCESS);
+    EXPECT_EQ(value, std::vector<uint8_t>({ 5 }));
+}
+}  // namespace Cloud
+}  // namespace OHOS
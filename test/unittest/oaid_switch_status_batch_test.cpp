@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "message_parcel.h"
+#include "rdb_errno.h"
+#include "rdb_helper.h"
+#include "rdb_open_callback.h"
+#include "rdb_store.h"
+#include "rdb_store_config.h"
+
+#define private public
+#include "oaid_rdb_manager.h"
+#include "oaid_service.h"
+#include "oaid_service_stub.h"
+#undef private
+#include "oaid_common.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+constexpr int32_t TEST_USER_ID = 100;
+const std::string TEST_DB_PATH = "/data/test/oaid_switch_status_batch_test.db";
+const std::string FAILING_BUNDLE_NAME = "com.example.fail";
+
+// Same table as OaidRdbManager, plus a trigger that makes the insert of FAILING_BUNDLE_NAME fail.
+const std::string CREATE_SWITCH_STATUS_TABLE_SQL = "CREATE TABLE IF NOT EXISTS anco_s_status ("
+    "user_id INTEGER NOT NULL, bn TEXT NOT NULL, uid TEXT NOT NULL, res INTEGER NOT NULL DEFAULT 0, "
+    "create_time INTEGER NOT NULL, update_time INTEGER NOT NULL, PRIMARY KEY (user_id, bn, uid))";
+const std::string CREATE_FAILING_TRIGGER_SQL = "CREATE TRIGGER IF NOT EXISTS fail_switch_status BEFORE INSERT ON "
+    "anco_s_status WHEN NEW.bn = '" + FAILING_BUNDLE_NAME + "' BEGIN SELECT RAISE(ABORT, 'injected'); END";
+
+class TestOpenCallback : public NativeRdb::RdbOpenCallback {
+public:
+    int OnCreate(NativeRdb::RdbStore &store) override
+    {
+        int ret = store.ExecuteSql(CREATE_SWITCH_STATUS_TABLE_SQL);
+        return (ret == NativeRdb::E_OK) ? store.ExecuteSql(CREATE_FAILING_TRIGGER_SQL) : ret;
+    }
+    int OnUpgrade(NativeRdb::RdbStore &store, int currentVersion, int targetVersion) override
+    {
+        return NativeRdb::E_OK;
+    }
+};
+
+void WriteRows(MessageParcel &data, uint32_t count, uint32_t rows)
+{
+    data.WriteUint32(count);
+    for (uint32_t i = 0; i < rows; i++) {
+        data.WriteInt32(TEST_USER_ID);
+        data.WriteString("com.example.app" + std::to_string(i));
+        data.WriteString(std::to_string(i));
+        data.WriteInt32(1);
+    }
+}
+}  // namespace
+
+class OaidSwitchStatusBatchTest : public testing::Test {
+public:
+    void SetUp() override
+    {
+        NativeRdb::RdbHelper::DeleteRdbStore(TEST_DB_PATH);
+        NativeRdb::RdbStoreConfig config(TEST_DB_PATH);
+        TestOpenCallback callback;
+        int errCode = NativeRdb::E_OK;
+        store_ = NativeRdb::RdbHelper::GetRdbStore(config, 1, callback, errCode);
+        ASSERT_NE(store_, nullptr);
+        // The manager of the test process is pointed at the test store, the service database is not touched.
+        OaidRdbManager::GetInstance().rdbStore_ = store_;
+    }
+
+    void TearDown() override
+    {
+        OaidRdbManager::GetInstance().rdbStore_ = nullptr;
+        store_ = nullptr;
+        NativeRdb::RdbHelper::DeleteRdbStore(TEST_DB_PATH);
+    }
+
+    // Status of one row, -1 when the row does not exist.
+    int32_t QueryStatus(const std::string &bundleName, const std::string &uid)
+    {
+        auto resultSet = store_->QuerySql("SELECT res FROM anco_s_status WHERE user_id = ? AND bn = ? AND uid = ?",
+            { NativeRdb::ValueObject(TEST_USER_ID), NativeRdb::ValueObject(bundleName),
+              NativeRdb::ValueObject(uid) });
+        int32_t status = -1;
+        if (resultSet != nullptr && resultSet->GoToFirstRow() == NativeRdb::E_OK) {
+            resultSet->GetInt(0, status);
+        }
+        if (resultSet != nullptr) {
+            resultSet->Close();
+        }
+        return status;
+    }
+
+    std::shared_ptr<NativeRdb::RdbStore> store_;
+};
+
+/**
+ * @tc.name: OaidSwitchStatusBatchTest001
+ * @tc.desc: The stub rejects an empty batch and a batch above ANCO_SWITCH_STATUS_BATCH_MAX_SIZE rows before
+ *           reading any row.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidSwitchStatusBatchTest, OaidSwitchStatusBatchTest001, TestSize.Level1)
+{
+    sptr<OAIDService> service = new OAIDService();
+    OAIDServiceStub::CallerInfo caller(getuid(), 0);
+    for (uint32_t count : { 0u, static_cast<uint32_t>(ANCO_SWITCH_STATUS_BATCH_MAX_SIZE + 1) }) {
+        MessageParcel data;
+        MessageParcel reply;
+        WriteRows(data, count, count);
+        EXPECT_EQ(service->OnSetAncoSwitchStatusBatch(data, reply, caller), ERR_INVALID_PARAM);
+        EXPECT_EQ(data.GetReadPosition(), sizeof(uint32_t));
+        EXPECT_EQ(reply.GetDataSize(), 0u);
+    }
+}
+
+/**
+ * @tc.name: OaidSwitchStatusBatchTest002
+ * @tc.desc: A count of exactly ANCO_SWITCH_STATUS_BATCH_MAX_SIZE passes the cap, a parcel one row short then
+ *           fails on the row read and nothing is written.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidSwitchStatusBatchTest, OaidSwitchStatusBatchTest002, TestSize.Level1)
+{
+    sptr<OAIDService> service = new OAIDService();
+    OAIDServiceStub::CallerInfo caller(getuid(), 0);
+    MessageParcel data;
+    MessageParcel reply;
+    uint32_t count = static_cast<uint32_t>(ANCO_SWITCH_STATUS_BATCH_MAX_SIZE);
+    WriteRows(data, count, count - 1);
+    EXPECT_EQ(service->OnSetAncoSwitchStatusBatch(data, reply, caller), ERR_INVALID_PARAM);
+    EXPECT_GT(data.GetReadPosition(), sizeof(uint32_t));
+    EXPECT_EQ(reply.GetDataSize(), 0u);
+    EXPECT_EQ(QueryStatus("com.example.app0", "0"), -1);
+}
+
+/**
+ * @tc.name: OaidSwitchStatusBatchTest003
+ * @tc.desc: A batch without failing rows is committed as a whole.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidSwitchStatusBatchTest, OaidSwitchStatusBatchTest003, TestSize.Level1)
+{
+    std::vector<AncoSwitchStatusInfo> infos = { { TEST_USER_ID, "com.example.a", "1", 1 },
+        { TEST_USER_ID, "com.example.b", "2", 0 }, { TEST_USER_ID, "com.example.c", "3", 1 } };
+    EXPECT_EQ(OaidRdbManager::GetInstance().InsertOrReplaceSwitchStatusBatch(infos), ERR_OK);
+    EXPECT_EQ(QueryStatus("com.example.a", "1"), 1);
+    EXPECT_EQ(QueryStatus("com.example.b", "2"), 0);
+    EXPECT_EQ(QueryStatus("com.example.c", "3"), 1);
+}
+
+/**
+ * @tc.name: OaidSwitchStatusBatchTest004
+ * @tc.desc: One failing row rolls back the rows before it, an existing row keeps its previous status, and the
+ *           rows after it are not written either.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidSwitchStatusBatchTest, OaidSwitchStatusBatchTest004, TestSize.Level1)
+{
+    auto &manager = OaidRdbManager::GetInstance();
+    ASSERT_EQ(manager.InsertOrReplaceSwitchStatus(TEST_USER_ID, "com.example.a", "1", 0), ERR_OK);
+
+    std::vector<AncoSwitchStatusInfo> infos = { { TEST_USER_ID, "com.example.a", "1", 1 },
+        { TEST_USER_ID, "com.example.b", "2", 1 }, { TEST_USER_ID, FAILING_BUNDLE_NAME, "3", 1 },
+        { TEST_USER_ID, "com.example.c", "4", 1 } };
+    EXPECT_EQ(manager.InsertOrReplaceSwitchStatusBatch(infos), ERR_DB_CONNECT_FAILED);
+    EXPECT_EQ(QueryStatus("com.example.a", "1"), 0);
+    EXPECT_EQ(QueryStatus("com.example.b", "2"), -1);
+    EXPECT_EQ(QueryStatus(FAILING_BUNDLE_NAME, "3"), -1);
+    EXPECT_EQ(QueryStatus("com.example.c", "4"), -1);
+
+    // The store is usable again, the transaction did not stay open.
+    EXPECT_EQ(manager.InsertOrReplaceSwitchStatusBatch({ { TEST_USER_ID, "com.example.b", "2", 1 } }), ERR_OK);
+    EXPECT_EQ(QueryStatus("com.example.b", "2"), 1);
+}
+}  // namespace Cloud
+}  // namespace OHOS
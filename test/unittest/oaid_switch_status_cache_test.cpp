@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "oaid_switch_status_cache.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Cloud {
+namespace {
+constexpr int32_t TEST_USER_ID = 100;
+constexpr int32_t OTHER_USER_ID = 101;
+}  // namespace
+
+class OaidSwitchStatusCacheTest : public testing::Test {};
+
+/**
+ * @tc.name: OaidSwitchStatusCacheTest001
+ * @tc.desc: Lookups before a load report NOT_LOADED, after it FOUND or ABSENT.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidSwitchStatusCacheTest, OaidSwitchStatusCacheTest001, TestSize.Level1)
+{
+    OaidSwitchStatusCache cache;
+    int32_t status = -1;
+    EXPECT_EQ(cache.Lookup(TEST_USER_ID, "com.example.a", "1", status),
+        OaidSwitchStatusCache::LookupResult::NOT_LOADED);
+    EXPECT_FALSE(cache.IsLoaded(TEST_USER_ID));
+
+    cache.LoadUser(TEST_USER_ID,
+        { { TEST_USER_ID, "com.example.a", "1", 1 }, { TEST_USER_ID, "com.example.a", "2", 0 } });
+    EXPECT_TRUE(cache.IsLoaded(TEST_USER_ID));
+    EXPECT_FALSE(cache.IsLoaded(OTHER_USER_ID));
+    ASSERT_EQ(cache.Lookup(TEST_USER_ID, "com.example.a", "1", status), OaidSwitchStatusCache::LookupResult::FOUND);
+    EXPECT_EQ(status, 1);
+    ASSERT_EQ(cache.Lookup(TEST_USER_ID, "com.example.a", "2", status), OaidSwitchStatusCache::LookupResult::FOUND);
+    EXPECT_EQ(status, 0);
+    EXPECT_EQ(cache.Lookup(TEST_USER_ID, "com.example.a", "3", status), OaidSwitchStatusCache::LookupResult::ABSENT);
+    EXPECT_EQ(cache.Lookup(TEST_USER_ID, "com.example.b", "1", status), OaidSwitchStatusCache::LookupResult::ABSENT);
+}
+
+/**
+ * @tc.name: OaidSwitchStatusCacheTest002
+ * @tc.desc: Put updates a loaded user and is ignored for a user that is not loaded.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidSwitchStatusCacheTest, OaidSwitchStatusCacheTest002, TestSize.Level1)
+{
+    OaidSwitchStatusCache cache;
+    cache.LoadUser(TEST_USER_ID, {});
+    cache.Put({ TEST_USER_ID, "com.example.a", "1", 1 });
+    cache.Put({ TEST_USER_ID, "com.example.a", "1", 0 });
+    cache.Put({ OTHER_USER_ID, "com.example.a", "1", 1 });
+
+    int32_t status = -1;
+    ASSERT_EQ(cache.Lookup(TEST_USER_ID, "com.example.a", "1", status), OaidSwitchStatusCache::LookupResult::FOUND);
+    EXPECT_EQ(status, 0);
+    EXPECT_EQ(cache.Lookup(OTHER_USER_ID, "com.example.a", "1", status),
+        OaidSwitchStatusCache::LookupResult::NOT_LOADED);
+}
+
+/**
+ * @tc.name: OaidSwitchStatusCacheTest003
+ * @tc.desc: Erased bundles become ABSENT, an erased user has to be loaded again, other users are untouched.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidSwitchStatusCacheTest, OaidSwitchStatusCacheTest003, TestSize.Level1)
+{
+    OaidSwitchStatusCache cache;
+    cache.LoadUser(TEST_USER_ID,
+        { { TEST_USER_ID, "com.example.a", "1", 1 }, { TEST_USER_ID, "com.example.b", "1", 1 } });
+    cache.LoadUser(OTHER_USER_ID, { { OTHER_USER_ID, "com.example.a", "1", 1 } });
+
+    int32_t status = -1;
+    cache.EraseBundles(TEST_USER_ID, { "com.example.a" });
+    EXPECT_EQ(cache.Lookup(TEST_USER_ID, "com.example.a", "1", status), OaidSwitchStatusCache::LookupResult::ABSENT);
+    EXPECT_EQ(cache.Lookup(TEST_USER_ID, "com.example.b", "1", status), OaidSwitchStatusCache::LookupResult::FOUND);
+    EXPECT_EQ(cache.Lookup(OTHER_USER_ID, "com.example.a", "1", status), OaidSwitchStatusCache::LookupResult::FOUND);
+
+    cache.EraseUser(TEST_USER_ID);
+    EXPECT_EQ(cache.Lookup(TEST_USER_ID, "com.example.b", "1", status),
+        OaidSwitchStatusCache::LookupResult::NOT_LOADED);
+    EXPECT_EQ(cache.Lookup(OTHER_USER_ID, "com.example.a", "1", status), OaidSwitchStatusCache::LookupResult::FOUND);
+}
+
+/**
+ * @tc.name: OaidSwitchStatusCacheTest004
+ * @tc.desc: Users of different shards are written and read concurrently, every write is seen afterwards.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidSwitchStatusCacheTest, OaidSwitchStatusCacheTest004, TestSize.Level1)
+{
+    constexpr int32_t userCount = 16;
+    constexpr int32_t appCount = 200;
+    OaidSwitchStatusCache cache;
+    for (int32_t userId = 0; userId < userCount; userId++) {
+        cache.LoadUser(userId, {});
+    }
+    std::vector<std::thread> threads;
+    for (int32_t userId = 0; userId < userCount; userId++) {
+        threads.emplace_back([&cache, userId]() {
+            int32_t status = 0;
+            for (int32_t app = 0; app < appCount; app++) {
+                cache.Put({ userId, "com.example." + std::to_string(app), std::to_string(app), app % 2 });
+                (void)cache.Lookup((userId + 1) % userCount, "com.example.0", "0", status);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (int32_t userId = 0; userId < userCount; userId++) {
+        for (int32_t app = 0; app < appCount; app++) {
+            int32_t status = -1;
+            ASSERT_EQ(cache.Lookup(userId, "com.example." + std::to_string(app), std::to_string(app), status),
+                OaidSwitchStatusCache::LookupResult::FOUND);
+            EXPECT_EQ(status, app % 2);
+        }
+    }
+}
+}  // namespace Cloud
+}  // namespace OHOS
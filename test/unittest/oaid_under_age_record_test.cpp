@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "oaid_under_age_record.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Cloud {
+class OaidUnderAgeRecordTest : public testing::Test {};
+
+/**
+ * @tc.name: OaidUnderAgeRecordTest001
+ * @tc.desc: A record decodes to the flag and time it was encoded with.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidUnderAgeRecordTest, OaidUnderAgeRecordTest001, TestSize.Level1)
+{
+    const int64_t updateTime = 1767225600123;
+    for (bool allow : { true, false }) {
+        std::vector<uint8_t> record = EncodeUnderAgeRecord(allow, updateTime);
+        ASSERT_EQ(record.size(), UNDER_AGE_RECORD_SIZE);
+        EXPECT_EQ(record[0], UNDER_AGE_RECORD_VERSION);
+        bool decodedAllow = !allow;
+        int64_t decodedTime = 0;
+        ASSERT_TRUE(DecodeUnderAgeRecord(record, decodedAllow, decodedTime));
+        EXPECT_EQ(decodedAllow, allow);
+        EXPECT_EQ(decodedTime, updateTime);
+    }
+}
+
+/**
+ * @tc.name: OaidUnderAgeRecordTest002
+ * @tc.desc: The time is stored little endian after the version and flag bytes.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidUnderAgeRecordTest, OaidUnderAgeRecordTest002, TestSize.Level1)
+{
+    std::vector<uint8_t> record = EncodeUnderAgeRecord(true, 0x0102030405060708);
+    std::vector<uint8_t> expected = { UNDER_AGE_RECORD_VERSION, 1, 0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 };
+    EXPECT_EQ(record, expected);
+}
+
+/**
+ * @tc.name: OaidUnderAgeRecordTest003
+ * @tc.desc: Truncated records and unknown versions are rejected, a longer record of a newer version is read.
+ * @tc.type: FUNC
+ */
+HWTEST_F(OaidUnderAgeRecordTest, OaidUnderAgeRecordTest003, TestSize.Level1)
+{
+    bool allow = false;
+    int64_t time = 0;
+    std::vector<uint8_t> record = EncodeUnderAgeRecord(true, 42);
+    EXPECT_FALSE(DecodeUnderAgeRecord({}, allow, time));
+    EXPECT_FALSE(DecodeUnderAgeRecord(std::vector<uint8_t>(record.begin(), record.end() - 1), allow, time));
+
+    std::vector<uint8_t> unknown = record;
+    unknown[0] = 0;
+    EXPECT_FALSE(DecodeUnderAgeRecord(unknown, allow, time));
+
+    std::vector<uint8_t> newer = record;
+    newer[0] = UNDER_AGE_RECORD_VERSION + 1;
+    newer.push_back(0xFF);
+    ASSERT_TRUE(DecodeUnderAgeRecord(newer, allow, time));
+    EXPECT_TRUE(allow);
+    EXPECT_EQ(time, 42);
+}
+}  // namespace Cloud
+}  // namespace OHOS
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_CLOUD_OAID_VALUE_H
+#define OHOS_CLOUD_OAID_VALUE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "parcel.h"
+
+namespace OHOS {
+namespace Cloud {
+namespace OaidValueDetail {
+constexpr size_t BYTE_VALUES = 256;
+using HexPairTable = std::array<char, BYTE_VALUES * 2>;
+
+// Two lower case hex characters per byte value, one lookup per byte when formatting.
+constexpr HexPairTable MakeHexPairTable()
+{
+    constexpr char hexDigits[] = "0123456789abcdef";
+    constexpr size_t halfByteBits = 4;
+    constexpr size_t lowHalfByteMask = 0x0F;
+    HexPairTable table {};
+    for (size_t value = 0; value < BYTE_VALUES; value++) {
+        table[value * 2] = hexDigits[value >> halfByteBits];      // 2 chars per byte
+        table[value * 2 + 1] = hexDigits[value & lowHalfByteMask];  // 2 chars per byte
+    }
+    return table;
+}
+
+inline constexpr HexPairTable HEX_PAIRS = MakeHexPairTable();
+}  // namespace OaidValueDetail
+
+/**
+ * OAID held as its 16 raw bytes. It is formatted to the canonical 8-4-4-4-12 lower case string only on demand,
+ * into a caller provided stack buffer, so passing it around never allocates.
+ */
+class OaidValue {
+public:
+    static constexpr size_t BYTE_SIZE = 16;
+    static constexpr size_t STRING_LENGTH = 36;
+    using FormatBuffer = std::array<char, STRING_LENGTH + 1>;
+
+    constexpr OaidValue() = default;
+
+    static OaidValue FromBytes(const uint8_t *bytes)
+    {
+        OaidValue value;
+        for (size_t i = 0; i < BYTE_SIZE; i++) {
+            value.bytes_[i] = bytes[i];
+        }
+        return value;
+    }
+
+    /**
+     * Parse the canonical string form, upper and lower case hex digits are accepted.
+     *
+     * @param str OAID string.
+     * @param value Parsed value.
+     * @return bool, false if str is not a well formed OAID.
+     */
+    static bool FromString(std::string_view str, OaidValue &value)
+    {
+        if (str.size() != STRING_LENGTH) {
+            return false;
+        }
+        OaidValue parsed;
+        size_t pos = 0;
+        for (size_t i = 0; i < BYTE_SIZE; i++) {
+            if (IsHyphenBefore(i)) {
+                if (str[pos] != '-') {
+                    return false;
+                }
+                pos++;
+            }
+            int high = HexValue(str[pos]);
+            int low = HexValue(str[pos + 1]);
+            if (high < 0 || low < 0) {
+                return false;
+            }
+            parsed.bytes_[i] = static_cast<uint8_t>((high << HALF_BYTE_BITS) | low);
+            pos += HEX_CHARS_PER_BYTE;
+        }
+        value = parsed;
+        return true;
+    }
+
+    const uint8_t *Data() const
+    {
+        return bytes_.data();
+    }
+
+    bool IsZero() const
+    {
+        for (uint8_t byte : bytes_) {
+            if (byte != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Format into buffer as a NUL terminated string of STRING_LENGTH characters.
+     */
+    void Format(FormatBuffer &buffer) const
+    {
+        size_t pos = 0;
+        for (size_t i = 0; i < BYTE_SIZE; i++) {
+            if (IsHyphenBefore(i)) {
+                buffer[pos++] = '-';
+            }
+            const char *pair = &OaidValueDetail::HEX_PAIRS[bytes_[i] * HEX_CHARS_PER_BYTE];
+            buffer[pos++] = pair[0];
+            buffer[pos++] = pair[1];
+        }
+        buffer[pos] = '\0';
+    }
+
+    /**
+     * Format for logs, only the first group is kept: "xxxxxxxx-****-****-****-************".
+     */
+    void FormatMasked(FormatBuffer &buffer) const
+    {
+        Format(buffer);
+        for (size_t pos = MASK_START; pos < STRING_LENGTH; pos++) {
+            if (buffer[pos] != '-') {
+                buffer[pos] = '*';
+            }
+        }
+    }
+
+    std::string ToString() const
+    {
+        FormatBuffer buffer;
+        Format(buffer);
+        return std::string(buffer.data(), STRING_LENGTH);
+    }
+
+    bool WriteToParcel(Parcel &parcel) const
+    {
+        return parcel.WriteBuffer(bytes_.data(), BYTE_SIZE);
+    }
+
+    static bool ReadFromParcel(Parcel &parcel, OaidValue &value)
+    {
+        const uint8_t *data = parcel.ReadBuffer(BYTE_SIZE);
+        if (data == nullptr) {
+            return false;
+        }
+        value = FromBytes(data);
+        return true;
+    }
+
+    bool operator==(const OaidValue &other) const
+    {
+        return bytes_ == other.bytes_;
+    }
+
+    bool operator!=(const OaidValue &other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    static constexpr int HALF_BYTE_BITS = 4;
+    static constexpr uint8_t LOW_HALF_BYTE_MASK = 0x0F;
+    static constexpr size_t HEX_CHARS_PER_BYTE = 2;
+    static constexpr size_t MASK_START = 9;  // Keep "xxxxxxxx-".
+    static constexpr int HEX_ALPHA_OFFSET = 10;
+
+    static constexpr bool IsHyphenBefore(size_t byteIndex)
+    {
+        return byteIndex == 4 || byteIndex == 6 || byteIndex == 8 || byteIndex == 10;  // 8-4-4-4-12 groups
+    }
+
+    static constexpr int HexValue(char c)
+    {
+        if (c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        if (c >= 'a' && c <= 'f') {
+            return c - 'a' + HEX_ALPHA_OFFSET;
+        }
+        if (c >= 'A' && c <= 'F') {
+            return c - 'A' + HEX_ALPHA_OFFSET;
+        }
+        return -1;
+    }
+
+    std::array<uint8_t, BYTE_SIZE> bytes_ {};
+};
+
+static_assert(std::is_trivially_copyable_v<OaidValue>, "OaidValue must stay trivially copyable");
+static_assert(sizeof(OaidValue) == OaidValue::BYTE_SIZE, "OaidValue must stay 16 bytes");
+}  // namespace Cloud
+}  // namespace OHOS
+#endif  // OHOS_CLOUD_OAID_VALUE_H